@@ -0,0 +1,97 @@
+#ifndef SIGNALS_BATCH_H__
+#define SIGNALS_BATCH_H__
+
+#include <cstddef>
+#include <iterator>
+
+#include "Signal.h"
+
+namespace signals {
+
+/**
+ * A contiguous range of signals, with the type of the signals erased. The 
+ * signals are addressed via their Signal base and the distance (stride) of two 
+ * consecutive signals in memory.
+ */
+class SignalBatch {
+
+public:
+
+	/**
+	 * Create a batch from the signals in [first, last).
+	 */
+	template <typename SignalType>
+	SignalBatch(SignalType* first, SignalType* last) :
+		_first(reinterpret_cast<char*>(static_cast<Signal*>(first))),
+		_size(last - first),
+		_stride(sizeof(SignalType)) {}
+
+	std::size_t size() const {
+
+		return _size;
+	}
+
+	Signal& operator[](std::size_t i) const {
+
+		return *reinterpret_cast<Signal*>(_first + i*_stride);
+	}
+
+private:
+
+	char*       _first;
+	std::size_t _size;
+	std::size_t _stride;
+};
+
+/**
+ * A contiguous range of signals, as received by batch callbacks. The signals 
+ * might be of a type derived from SignalType.
+ */
+template <typename SignalType>
+class Batch {
+
+public:
+
+	class iterator {
+
+	public:
+
+		typedef std::forward_iterator_tag iterator_category;
+		typedef SignalType                value_type;
+		typedef std::ptrdiff_t            difference_type;
+		typedef SignalType*               pointer;
+		typedef SignalType&               reference;
+
+		iterator(const SignalBatch& batch, std::size_t i) : _batch(&batch), _i(i) {}
+
+		SignalType& operator*() const { return static_cast<SignalType&>((*_batch)[_i]); }
+		SignalType* operator->() const { return &**this; }
+		iterator& operator++() { _i++; return *this; }
+		iterator operator++(int) { iterator i = *this; _i++; return i; }
+		bool operator==(const iterator& other) const { return _i == other._i; }
+		bool operator!=(const iterator& other) const { return _i != other._i; }
+
+	private:
+
+		const SignalBatch* _batch;
+		std::size_t        _i;
+	};
+
+	Batch(const SignalBatch& batch) :
+		_batch(batch) {}
+
+	std::size_t size() const { return _batch.size(); }
+
+	SignalType& operator[](std::size_t i) const { return static_cast<SignalType&>(_batch[i]); }
+
+	iterator begin() const { return iterator(_batch, 0); }
+	iterator end() const { return iterator(_batch, _batch.size()); }
+
+private:
+
+	const SignalBatch& _batch;
+};
+
+} // namespace signals
+
+#endif // SIGNALS_BATCH_H__
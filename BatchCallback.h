@@ -0,0 +1,111 @@
+#ifndef SIGNALS_BATCH_CALLBACK_H__
+#define SIGNALS_BATCH_CALLBACK_H__
+
+#include <functional>
+#include <typeinfo>
+#include <boost/noncopyable.hpp>
+
+#include "Batch.h"
+#include "CallbackBase.h"
+#include "CallbackInvocation.h"
+#include "CallbackTracking.h"
+#include "SignalTraits.h"
+#include "Slot.h"
+
+namespace signals {
+
+/**
+ * Callback for a specific signal type that receives batches of signals. When 
+ * a slot sends a batch via Slot::sendBatch(), the whole batch is passed in one 
+ * call. Single signals are passed as batches of size one. Tracking policies 
+ * are the same as for Callback.
+ */
+template <
+	typename SignalType,
+	typename TrackingPolicy = NoTracking>
+class BatchCallback :
+		public CallbackBase,
+		public TrackingPolicy,
+		public boost::noncopyable /* prevents references to _callback to get invalidated */ {
+
+public:
+
+	/**
+	 * Create a new batch callback.
+	 *
+	 * @param callback
+	 *              Any expression that can be cast into a 
+	 *              std::function<void(const Batch<SignalType>&)>.
+	 *
+	 * @param invocation
+	 *              Optional invocation type. See CallbackInvocation.
+	 */
+	template <typename FunctorType>
+	BatchCallback(FunctorType callback, CallbackInvocation invocation = Exclusive) :
+		CallbackBase(SignalTraits<SignalType>::id(), typeid(BatchCallback).name()),
+		_callback(callback) {
+
+		FunctorType* functor = _callback.template target<FunctorType>();
+
+		if (functor)
+			setDelegate(Delegate::fromBatchFunctor<SignalType>(*functor));
+		else
+			setDelegate(Delegate::fromBatchFunctor<SignalType>(_callback));
+
+		if (invocation == Transparent)
+			setTransparent();
+	}
+
+	/**
+	 * Try to connect this callback to the given slot.
+	 *
+	 * @return
+	 *         true, if the callback and slot are type compatible and have been 
+	 *         connected.
+	 */
+	bool connect(SlotBase& slot) {
+
+		if (!accepts(slot.getSignalType()))
+			return false;
+
+		slot.addCallback(*this);
+
+		return true;
+	}
+
+	/**
+	 * Disconnect this callback from the given slot.
+	 *
+	 * @return
+	 *         true, if the callback and slot are type compatible and have been 
+	 *         disconnected.
+	 */
+	bool disconnect(SlotBase& slot) {
+
+		if (!accepts(slot.getSignalType()))
+			return false;
+
+		slot.removeCallback(*this);
+
+		return true;
+	}
+
+private:
+
+	const Signal& createSignal() const {
+
+		return SignalTraits<SignalType>::Reference;
+	}
+
+	bool getTracking(CallbackTracker& tracker) const {
+
+		return TrackingPolicy::setTracking(tracker);
+	}
+
+	// the functor provided by the user
+	std::function<void(const Batch<SignalType>&)> _callback;
+};
+
+} // namespace signals
+
+#endif // SIGNALS_BATCH_CALLBACK_H__
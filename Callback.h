@@ -1,11 +1,12 @@
 #ifndef SIGNALS_CALLBACK_H__
 #define SIGNALS_CALLBACK_H__
 
-#include <boost/function.hpp>
+#include <functional>
+#include <typeinfo>
+#include <boost/noncopyable.hpp>
 
 #include "CallbackBase.h"
 #include "CallbackInvocation.h"
-#include "CallbackInvoker.h"
 #include "CallbackTracking.h"
 #include "CastingPolicy.h"
 #include "SignalTraits.h"
@@ -18,9 +19,11 @@ namespace signals {
  * template parameter. This can be used to track the lifetime of an object and 
  * invoke the callback only if the tracked object is still alive. Currently 
  * available are NoTracking (default), WeakTracking (track an arbitrary object 
- * via a weak pointer, invoke callback only if weak pointer can be locked), and 
+ * via a weak pointer, invoke callback only if weak pointer can be locked), 
  * SharedTracking (keep an arbitrary object alive via a shared pointer as long 
- * as any invoker of the callback is used).
+ * as any invoker of the callback is used), and EpochTracking (like weak 
+ * tracking for objects owned by an EpochPtr, without contention between 
+ * sending threads).
  */
 template <
 	typename SignalType,
@@ -37,15 +40,23 @@ public:
 	 *
 	 * @param callback
 	 *              Any expression that can be cast into a 
-	 *              std::function<void(SignalType&)>.
+	 *              std::function<void(SignalType&)>. Functors that accept a 
+	 *              const SignalType& receive const signals without a copy.
 	 *
 	 * @param invocation
 	 *              Optional invocation type. Influences which callbacks are  
 	 *              connected to signals, if several callbacks are compatible.  
 	 *              See CallbackInvocation.
 	 */
-	Callback(std::function<void(SignalType&)> callback, CallbackInvocation invocation = Exclusive) :
-		CallbackBase([callback](Signal& signal){ callback(static_cast<SignalType&>(signal)); }) {
+	template <typename FunctorType>
+	Callback(FunctorType callback, CallbackInvocation invocation = Exclusive) :
+		CallbackBase(SignalTraits<SignalType>::id(), typeid(Callback).name()),
+		_callback(callback) {
+
+		// Let the delegate point directly to the stored functor, such that 
+		// invokers of this callback call it without going through 
+		// std::function.
+		setDelegate(createDelegate(callback));
 
 		if (invocation == Transparent)
 			setTransparent();
@@ -60,9 +71,7 @@ public:
 	 */
 	bool connect(SlotBase& slot) {
 
-		const Signal& reference = slot.createSignal();
-
-		if (!accepts(reference))
+		if (!accepts(slot.getSignalType()))
 			return false;
 
 		slot.addCallback(*this);
@@ -79,9 +88,7 @@ public:
 	 */
 	bool disconnect(SlotBase& slot) {
 
-		const Signal& reference = slot.createSignal();
-
-		if (!accepts(reference))
+		if (!accepts(slot.getSignalType()))
 			return false;
 
 		slot.removeCallback(*this);
@@ -91,19 +98,29 @@ public:
 
 private:
 
-	/**
-	 * Return true if this callback can accept the provided signal, i.e., if the 
-	 * signal's type is equal to or a superclass of SignalType.
-	 */
-	bool accepts(const Signal& signal) const {
+	const Signal& createSignal() const {
 
-		return dynamic_cast<const SignalType*>(&signal);
+		return SignalTraits<SignalType>::Reference;
 	}
 
-	const Signal& createSignal() const {
+	bool getTracking(CallbackTracker& tracker) const {
 
-		return SignalTraits<SignalType>::Reference;
+		return TrackingPolicy::setTracking(tracker);
 	}
+
+	template <typename FunctorType>
+	Delegate createDelegate(const FunctorType&) {
+
+		FunctorType* functor = _callback.template target<FunctorType>();
+
+		if (!functor)
+			return Delegate::fromFunctor<SignalType>(_callback);
+
+		return Delegate::fromFunctor<SignalType>(*functor);
+	}
+
+	// the functor provided by the user
+	std::function<void(SignalType&)> _callback;
 };
 
 } // namespace signals
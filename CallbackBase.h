@@ -1,22 +1,50 @@
 #ifndef SIGNALS_CALLBACK_BASE_H__
 #define SIGNALS_CALLBACK_BASE_H__
 
+#include <boost/shared_ptr.hpp>
+
+#include "Delegate.h"
+#include "Instrumentation.h"
+#include "SignalTypes.h"
+
 namespace signals {
 
 // forward declarations
 class Signal;
 class SlotBase;
+class CallbackTracker;
+class ReceiverAffinity;
 
 class CallbackBase {
 
 public:
 
-	CallbackBase(std::function<void(Signal&)> relayFunction) :
-		_relayFunction(relayFunction),
+	/**
+	 * @param signalType
+	 *              The type of the signals accepted by this callback.
+	 *
+	 * @param name
+	 *              Optional mangled type name of the most derived class (as 
+	 *              returned by typeid().name()), reported by Instrumentation.
+	 */
+	CallbackBase(SignalTypeId signalType, const char* name = 0) :
+		_signalType(signalType),
 		_isTransparent(false),
-		_precedence(0) {}
+		_precedence(0) {
 
-	virtual ~CallbackBase() {}
+#if SIGNALS_INSTRUMENTATION
+		Instrumentation::registerCallback(*this, name);
+#else
+		(void)name;
+#endif
+	}
+
+	virtual ~CallbackBase() {
+
+#if SIGNALS_INSTRUMENTATION
+		Instrumentation::unregisterCallback(*this);
+#endif
+	}
 
 	/**
 	 * Make this callback transparent. Transparent callbacks will always be
@@ -80,43 +108,107 @@ public:
 		// Return true, if the other callback accepts our signals as well. This
 		// means that our signal type ≤ other signal type, i.e., we are more
 		// specific.
-		return other.accepts(createSignal());
+		return other.accepts(_signalType);
 	}
 
 	/**
-	 * Get the relay function, i.e., the most general form of the function 
-	 * provided by this callback. Calling this function with the signal (and 
-	 * derived signals) provided by this callback should be valid.
+	 * Get the id of the signal type this callback accepts.
 	 */
-	const std::function<void(Signal&)>& relayFunction() const {
+	SignalTypeId getSignalType() const {
 
-		return _relayFunction;
+		return _signalType;
 	}
 
 	/**
-	 * Create a reference signal for run-time type inference. This reference is
-	 * used to find compatible pairs of slots and callbacks.
+	 * Get the delegate of this callback, i.e., the most general form of the 
+	 * function provided by this callback. Calling the delegate with the signal 
+	 * (and derived signals) accepted by this callback is valid.
+	 */
+	const Delegate& delegate() const {
+
+		return _delegate;
+	}
+
+	/**
+	 * Get the tracking information of this callback. Called by slots on 
+	 * connection.
+	 *
+	 * @return false, if this callback is not tracked.
+	 */
+	virtual bool getTracking(CallbackTracker&) const {
+
+		return false;
+	}
+
+	/**
+	 * Bind this callback to the owner thread of a receiver, see 
+	 * Receiver::setExecutor(). Has to be set before connecting.
+	 */
+	void setAffinity(boost::shared_ptr<ReceiverAffinity> affinity) {
+
+		_affinity = affinity;
+	}
+
+	/**
+	 * Get the affinity of this callback, or an empty pointer if the callback 
+	 * can be called from any thread.
+	 */
+	const boost::shared_ptr<ReceiverAffinity>& getAffinity() const {
+
+		return _affinity;
+	}
+
+	/**
+	 * Create a reference signal for run-time type inference. Compatible pairs
+	 * of slots and callbacks are found via their signal type ids, see
+	 * SignalTypes.
 	 */
 	virtual const Signal& createSignal() const = 0;
 
+#if SIGNALS_INSTRUMENTATION
+	CallbackStatistics& statistics() const { return _statistics; }
+#endif
+
 protected:
 
 	/**
-	 * Return true, if the passed signal can be cast to the signal type this
-	 * callback accepts.
+	 * Return true, if signals of the given type can be cast to the signal type
+	 * this callback accepts.
 	 */
-	virtual bool accepts(const Signal& signal) const = 0;
+	bool accepts(SignalTypeId signalType) const {
+
+		return SignalTypes::isCompatible(signalType, _signalType);
+	}
+
+	/**
+	 * Set the delegate of this callback. To be called by implementations in 
+	 * their constructor.
+	 */
+	void setDelegate(const Delegate& delegate) {
+
+		_delegate = delegate;
+	}
 
 private:
 
+	// the signal type this callback accepts
+	SignalTypeId _signalType;
+
 	// the most general way to provide the callback
-	std::function<void(Signal&)> _relayFunction;
+	Delegate _delegate;
 
 	// indicates that this is a transparent callback
 	bool _isTransparent;
 
 	// final sorting criteria for otherwise equal callbacks
 	unsigned int _precedence;
+
+	// the thread this callback has to be called in, if any
+	boost::shared_ptr<ReceiverAffinity> _affinity;
+
+#if SIGNALS_INSTRUMENTATION
+	mutable CallbackStatistics _statistics;
+#endif
 };
 
 } // namespace signals
@@ -1,7 +1,10 @@
 #ifndef SIGNALS_CALLBACK_COMPARATOR_H__
 #define SIGNALS_CALLBACK_COMPARATOR_H__
 
+#include <cstdint>
+
 #include "CallbackBase.h"
+#include "SignalTypes.h"
 
 namespace signals {
 
@@ -14,28 +17,29 @@ struct CallbackComparator {
 
 	bool operator()(const CallbackBase* a, const CallbackBase* b) const {
 
-		// both are transparent, the precedence decides
-		if (a->isTransparent() && b->isTransparent())
-			return a->getPrecedence() > b->getPrecedence();
+		return key(*a) < key(*b);
+	}
 
-		// both are exclusive, casting decides, then precedence
-		if (!a->isTransparent() && !b->isTransparent()) {
+	/**
+	 * Get the sort key of a callback. Exclusive callbacks are ordered by the 
+	 * number of ancestors of their signal type (a derived signal type has more 
+	 * ancestors than its base), then by precedence. Transparent callbacks are 
+	 * ordered by precedence only. The key changes only when new signal types 
+	 * get registered.
+	 */
+	static std::uint64_t key(const CallbackBase& callback) {
 
-			if (*a < *b)
-				return true;
+		std::uint64_t precedence = ~callback.getPrecedence() & 0xffffffff;
 
-			if (*b < *a)
-				return false;
+		if (callback.isTransparent())
+			return (std::uint64_t(1) << 63) | precedence;
 
-			return a->getPrecedence() > b->getPrecedence();
-		}
+		std::uint64_t specificity = ~SignalTypes::numAncestors(callback.getSignalType()) & 0x7fffffff;
 
-		// exactly one of them is transparent, sort it to the back
-		return b->isTransparent();
+		return (specificity << 32) | precedence;
 	}
 };
 
 } // namespace signals
 
 #endif // SIGNALS_CALLBACK_COMPARATOR_H__
-
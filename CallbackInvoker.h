@@ -1,16 +1,21 @@
 #ifndef SIGNALS_CALLBACK_INVOKER_H__
 #define SIGNALS_CALLBACK_INVOKER_H__
 
-#include <boost/function.hpp>
-#include <boost/shared_ptr.hpp>
-#include "Logging.h"
+#if SIGNALS_INSTRUMENTATION
+#include <chrono>
+#endif
+
 #include "CallbackBase.h"
+#include "Delegate.h"
+#include "Instrumentation.h"
 
 namespace signals {
 
 /**
  * Generic functor to send signals of type SignalType to a callback. The 
- * callback is stored as a std::function.
+ * callback's delegate is stored by value. Tracking of callbacks is done by 
+ * wrapping invokers in a SlotInvoker, such that this invoker is nothing but 
+ * a delegate.
  */
 template <typename SignalType>
 class CallbackInvoker {
@@ -20,136 +25,86 @@ public:
 	// accepts all callbacks
 	typedef CallbackBase CallbackBaseType;
 
-	/**
-	 * Lock to guard this callback invoker. Successful locking guarantees that 
-	 * the weakly tracked object (if it was set) is still alive and will stay 
-	 * alive for the duration of the lock.
-	 */
-	class Lock {
-
-	public:
-
-		Lock(bool isGood) :
-			_isGood(isGood),
-			_isWeakTracking(false) {
-
-			LOG_ALL(signalslog) << "created an always " << (isGood ? "good" : "bad") << " lock" << std::endl;
-		}
-
-		Lock(boost::weak_ptr<void> weakTrackedObject) :
-			_isGood(true),
-			_isWeakTracking(true),
-			_weakObjectLock(weakTrackedObject.lock()) {}
-
-		operator bool() {
-
-			if (!_isGood)
-				return false;
-
-			if (_isWeakTracking)
-				return static_cast<bool>(_weakObjectLock);
-
-			return true;
-		}
-
-	private:
-
-		bool _isGood;
-		bool _isWeakTracking;
-
-		boost::shared_ptr<void> _weakObjectLock;
-	};
-
 	CallbackInvoker(const CallbackBase& callback) :
-		_callback(boost::ref(callback.relayFunction())),
-		_isWeakTracking(false),
-		_isSharedTracking(false) {}
+		_delegate(callback.delegate())
+#if SIGNALS_INSTRUMENTATION
+		, _statistics(&callback.statistics())
+#endif
+		{}
 
 	/**
-	 * Register an object for weak tracking. The invoker will only be successful 
-	 * locked, if the tracked object does still exist.
+	 * Send a signal via this callback invoker.
 	 */
-	void setWeakTracking(boost::weak_ptr<void> object) {
+	template <typename T>
+	bool operator()(T& signal) const {
 
-		_weaklyTrackedObject = object;
-		_isWeakTracking = true;
-	}
+#if SIGNALS_INSTRUMENTATION
+		auto start = std::chrono::steady_clock::now();
+#endif
 
-	/**
-	 * Register an object for shared tracking. As long as this invoker exists, 
-	 * the registered object will be kept alive.
-	 */
-	void setSharedTracking(boost::shared_ptr<void> object) {
+		_delegate(signal);
+
+#if SIGNALS_INSTRUMENTATION
+		_statistics->recordLatency(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+#endif
 
-		_sharedTrackedObject = object;
-		_isSharedTracking = true;
+		return true;
 	}
 
 	/**
-	 * Lock this callback invoker. If a weak tracking object was set, successful 
-	 * locking ensures that the object still exists and will be alive for the 
-	 * duration of the lock.
-	 *
-	 * Usage:
-	 *
-	 *   CallbackInvoker<MySignal>::Lock lock = invoker.lock();
-	 *
-	 *   if (lock)
-	 *     invoker(signal); // save to assume weak tracked object exists
+	 * Send a batch of signals via this callback invoker.
 	 */
-	Lock lock() {
+	template <typename T>
+	bool operator()(T* first, T* last) const {
 
-		LOG_ALL(signalslog) << "create lock, weak tracking = " << _isWeakTracking << ", shared tracking = " << _isSharedTracking << ", shared object = " << _sharedTrackedObject << std::endl;
+#if SIGNALS_INSTRUMENTATION
+		auto start = std::chrono::steady_clock::now();
+#endif
 
-		if (_isWeakTracking)
-			return Lock(_weaklyTrackedObject);
-		else if (_isSharedTracking && !_sharedTrackedObject)
-			return Lock(false);
+		_delegate(SignalBatch(first, last));
 
-		return Lock(true);
+#if SIGNALS_INSTRUMENTATION
+		_statistics->recordLatency(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+#endif
+
+		return true;
 	}
 
 	/**
-	 * Send a signal via this callback invoker.
+	 * Returns true, if the callback does not modify the signals it receives.
 	 */
-	template <typename T>
-	bool operator()(T& signal) {
+	bool isReadOnly() const {
 
-		Lock l = lock();
-
-		if (!l)
-			return false;
-
-		boost::unwrap_ref(_callback)(signal);
-
-		return true;
+		return _delegate.isReadOnly();
 	}
 
 	/**
 	 * Comparison operator. Two invokers are considered equal, if they call the 
 	 * same function.
 	 */
-	bool operator==(const CallbackInvoker<SignalType>& other) {
+	bool operator==(const CallbackInvoker<SignalType>& other) const {
 
-		return (_callback.get_pointer() == other._callback.get_pointer());
+		return _delegate == other._delegate;
 	}
 
 private:
 
 	// the function that will be called by this invoker
-	boost::reference_wrapper<const std::function<void(Signal&)> > _callback;
+	Delegate _delegate;
 
-	// weak pointer to an object that is tracked by this invoker
-	boost::weak_ptr<void> _weaklyTrackedObject;
-
-	// shared pointer to an object that is tracked by this invoker
-	boost::shared_ptr<void> _sharedTrackedObject;
-
-	bool _isWeakTracking;
-	bool _isSharedTracking;
+#if SIGNALS_INSTRUMENTATION
+	// the statistics of the callback
+	CallbackStatistics* _statistics;
+#endif
 };
 
+#if !SIGNALS_INSTRUMENTATION
+// invokers are stored inline in slots, see Slot::InlineTargets
+static_assert(
+		sizeof(CallbackInvoker<Signal>) == sizeof(Delegate),
+		"CallbackInvoker should be nothing but a delegate");
+#endif
+
 } // namespace signals
 
 #endif // SIGNALS_CALLBACK_INVOKER_H__
-
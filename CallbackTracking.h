@@ -1,87 +1,279 @@
 #ifndef SIGNALS_CALLBACK_TRACKING_H__
 #define SIGNALS_CALLBACK_TRACKING_H__
 
-#include "CallbackInvoker.h"
+#include <boost/shared_ptr.hpp>
+#include <boost/weak_ptr.hpp>
+
+#include "Epochs.h"
 
 namespace signals {
 
+/**
+ * Tracking information of a callback, as it is kept by the slots the callback 
+ * is connected to. Filled by the tracking policy of the callback on 
+ * connection.
+ */
+class CallbackTracker {
+
+public:
+
+	/**
+	 * Lock to guard a tracked callback. Successful locking guarantees that the 
+	 * weakly tracked object (if it was set) is still alive and will stay alive 
+	 * for the duration of the lock.
+	 */
+	class Lock {
+
+	public:
+
+		Lock(bool isGood) :
+			_epochGuard(false),
+			_isGood(isGood) {}
+
+		Lock(boost::shared_ptr<void> weakObjectLock) :
+			_epochGuard(false),
+			_isGood(static_cast<bool>(weakObjectLock)),
+			_weakObjectLock(weakObjectLock) {}
+
+		Lock(const EpochLifetime& lifetime) :
+			_epochGuard(true),
+			_isGood(lifetime.alive()) {}
+
+		operator bool() const {
+
+			return _isGood;
+		}
+
+	private:
+
+		// keeps an epoch tracked object from being deleted, declared first to 
+		// be entered before the liveness check
+		Epochs::Guard _epochGuard;
+
+		bool _isGood;
+
+		boost::shared_ptr<void> _weakObjectLock;
+	};
+
+	CallbackTracker() :
+		_mode(SharedMode) {}
+
+	/**
+	 * Register an object for weak tracking. The tracker will only be 
+	 * successfully locked, if the tracked object does still exist.
+	 */
+	void setWeakTracking(boost::weak_ptr<void> object) {
+
+		_weaklyTrackedObject = object;
+		_mode = WeakMode;
+	}
+
+	/**
+	 * Register an object for shared tracking. As long as this tracker exists, 
+	 * the registered object will be kept alive.
+	 */
+	void setSharedTracking(boost::shared_ptr<void> object) {
+
+		_trackedObject = object;
+		_mode = SharedMode;
+	}
+
+	/**
+	 * Register the lifetime of an object owned by an EpochPtr. The tracker 
+	 * will only be successfully locked, if the object was not retired yet. 
+	 * Locking does not write to memory shared with other threads.
+	 */
+	void setEpochTracking(boost::shared_ptr<EpochLifetime> lifetime) {
+
+		_trackedObject = lifetime;
+		_mode = EpochMode;
+	}
+
+	/**
+	 * Lock this tracker. If a weak tracking object was set, successful locking 
+	 * ensures that the object still exists and will be alive for the duration 
+	 * of the lock.
+	 *
+	 * Usage:
+	 *
+	 *   CallbackTracker::Lock lock = tracker.lock();
+	 *
+	 *   if (lock)
+	 *     invoker(signal); // save to assume weak tracked object exists
+	 */
+	Lock lock() const {
+
+		switch (_mode) {
+
+			case WeakMode:
+				return Lock(_weaklyTrackedObject.lock());
+
+			case EpochMode:
+				return _trackedObject ? Lock(epochLifetime()) : Lock(false);
+
+			default:
+				return Lock(static_cast<bool>(_trackedObject));
+		}
+	}
+
+	/**
+	 * Check, without locking, whether this tracker can not be locked anymore.
+	 */
+	bool expired() const {
+
+		switch (_mode) {
+
+			case WeakMode:
+				return _weaklyTrackedObject.expired();
+
+			case EpochMode:
+				return !_trackedObject || !epochLifetime().alive();
+
+			default:
+				return !_trackedObject;
+		}
+	}
+
+private:
+
+	enum Mode {
+
+		SharedMode,
+		WeakMode,
+		EpochMode
+	};
+
+	const EpochLifetime& epochLifetime() const {
+
+		return *static_cast<const EpochLifetime*>(_trackedObject.get());
+	}
+
+	// weak pointer to an object that is tracked by this tracker
+	boost::weak_ptr<void> _weaklyTrackedObject;
+
+	// shared pointer to an object that is kept alive by this tracker, or the 
+	// EpochLifetime of an object owned by an EpochPtr
+	boost::shared_ptr<void> _trackedObject;
+
+	unsigned char _mode;
+};
+
 /**
  * No-tracking strategy for callbacks. The slots will only keep the plain 
- * functor implemented by the callback.
+ * delegate of the callback.
  */
 class NoTracking {
 
-public:
+protected:
 
-	//template <typename SignalType>
-	//CallbackInvoker<SignalType> createInvoker(boost::reference_wrapper<boost::function<void(SignalType&)> > callback) {
+	bool setTracking(CallbackTracker&) const {
 
-		//return CallbackInvoker<SignalType>(callback);
-	//}
+		return false;
+	}
 };
 
 /**
  * Weak pointer tracking strategy for callbacks. For callbacks that use this 
  * strategy, a connected slot will keep a weak pointer to the callback's holder 
- * (set via track() on the callback). The weak pointer is locked whenever a 
- * signal needs to be sent. If locking fails, i.e., the holder does not live 
- * anymore, the callback gets automatically removed from the slot.
+ * (set via track() on the callback before connecting). The weak pointer is 
+ * locked whenever a signal needs to be sent. If locking fails, i.e., the 
+ * holder does not live anymore, the callback gets automatically removed from 
+ * the slot.
  */
 template <typename HolderType>
 class WeakTracking {
 
 public:
 
-	//void track(boost::shared_ptr<HolderType> holder) const {
+	void track(boost::shared_ptr<HolderType> holder) const {
+
+		_holder = holder;
+	}
 
-		//_holder = holder;
-	//}
+protected:
 
-	//template <typename SignalType>
-	//CallbackInvoker<SignalType> createInvoker(boost::reference_wrapper<boost::function<void(SignalType&)> > callback) {
+	bool setTracking(CallbackTracker& tracker) const {
 
-		//CallbackInvoker<SignalType> invoker(callback);
-		//invoker.setWeakTracking(_holder);
+		tracker.setWeakTracking(_holder);
 
-		//return invoker;
-	//}
+		return true;
+	}
 
 private:
 
-	//mutable boost::weak_ptr<HolderType> _holder;
+	mutable boost::weak_ptr<HolderType> _holder;
 };
 
 /**
  * Shared pointer tracking for callbacks. For callbacks that use this strategy, 
- * a connected slot will keep a shared pointer to the callback's holder and thus 
- * makes sure that the holder will live at least as long as the connection to 
- * the slot is established.
+ * a connected slot will keep a shared pointer to the callback's holder (set 
+ * via track() on the callback before connecting) and thus makes sure that the 
+ * holder will live at least as long as the connection to the slot is 
+ * established.
  */
 template <typename HolderType>
 class SharedTracking {
 
 public:
 
-	//void track(boost::shared_ptr<HolderType> holder) const {
+	void track(boost::shared_ptr<HolderType> holder) const {
+
+		_holder = holder;
+	}
+
+protected:
+
+	bool setTracking(CallbackTracker& tracker) const {
+
+		tracker.setSharedTracking(_holder.lock());
+
+		return true;
+	}
+
+private:
+
+	// only a weak pointer, since the holder usually owns the callback
+	mutable boost::weak_ptr<HolderType> _holder;
+};
+
+/**
+ * Epoch-based tracking strategy for callbacks. The holder of the callback is 
+ * owned by an EpochPtr (set via track() on the callback before connecting). 
+ * Like with WeakTracking, the callback gets removed from the slot once the 
+ * holder is gone. Sending, however, only checks a liveness flag inside an 
+ * Epochs::Guard, instead of locking a weak pointer. Senders in many threads 
+ * therefore do not contend on the reference count of the holder. Slots with 
+ * the MultiThreaded policy read their invokers inside an Epochs::Guard as 
+ * well, the guard of the callback is nested in it and only increments a 
+ * per-thread counter. Such sends write to memory shared with other senders 
+ * only when they occasionally collect retired objects (see Epochs). Resetting 
+ * the EpochPtr retires the holder, which is deleted after all sends that 
+ * might still use it have finished.
+ */
+template <typename HolderType>
+class EpochTracking {
+
+public:
+
+	void track(const EpochPtr<HolderType>& holder) const {
 
-		//_holder = holder;
-	//}
+		_lifetime = holder.lifetime();
+	}
 
-	//template <typename SignalType>
-	//CallbackInvoker<SignalType> createInvoker(boost::reference_wrapper<boost::function<void(SignalType&)> > callback) {
+protected:
 
-		//CallbackInvoker<SignalType> invoker(callback);
-		//invoker.setSharedTracking(_holder.lock());
+	bool setTracking(CallbackTracker& tracker) const {
 
-		//return invoker;
-	//}
+		tracker.setEpochTracking(_lifetime);
+
+		return true;
+	}
 
 private:
 
-	//mutable boost::weak_ptr<HolderType> _holder;
+	mutable boost::shared_ptr<EpochLifetime> _lifetime;
 };
 
 } // namespace signals
 
 #endif // SIGNALS_CALLBACK_TRACKING_H__
-
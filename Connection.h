@@ -0,0 +1,145 @@
+#ifndef SIGNALS_CONNECTION_H__
+#define SIGNALS_CONNECTION_H__
+
+#include <cstdint>
+#include <boost/noncopyable.hpp>
+
+#include "SlotBase.h"
+
+namespace signals {
+
+/**
+ * Handle to a connection between a slot and a callback, as returned by 
+ * Slot::connect(CallbackBase&). Disconnecting through the handle does not 
+ * search the slot for the callback.
+ *
+ * The slot has to outlive the handle, or the handle has to be released before 
+ * the slot gets destructed.
+ */
+class Connection {
+
+public:
+
+	/**
+	 * Create an empty connection handle.
+	 */
+	Connection() :
+		_slot(0),
+		_id(0) {}
+
+	Connection(SlotBase& slot, std::uint64_t id) :
+		_slot(&slot),
+		_id(id) {}
+
+	/**
+	 * Disconnect the callback from the slot and reset this handle.
+	 *
+	 * @return true, if the connection still existed.
+	 */
+	bool disconnect() {
+
+		if (!_slot)
+			return false;
+
+		bool disconnected = _slot->removeConnection(_id);
+
+		release();
+
+		return disconnected;
+	}
+
+	/**
+	 * Reset this handle without disconnecting.
+	 */
+	void release() {
+
+		_slot = 0;
+		_id   = 0;
+	}
+
+	/**
+	 * Returns true, if this handle refers to a connection. The connection 
+	 * might have been removed by other means than this handle, though.
+	 */
+	operator bool() const {
+
+		return _slot != 0;
+	}
+
+private:
+
+	SlotBase*     _slot;
+	std::uint64_t _id;
+};
+
+/**
+ * Connection handle that disconnects on destruction.
+ *
+ * Usage:
+ *
+ *   ScopedConnection connection(slot.connect(callback));
+ */
+class ScopedConnection : public boost::noncopyable {
+
+public:
+
+	ScopedConnection() {}
+
+	ScopedConnection(const Connection& connection) :
+		_connection(connection) {}
+
+	ScopedConnection(ScopedConnection&& other) :
+		_connection(other.release()) {}
+
+	ScopedConnection& operator=(ScopedConnection&& other) {
+
+		if (this != &other) {
+
+			_connection.disconnect();
+			_connection = other.release();
+		}
+
+		return *this;
+	}
+
+	~ScopedConnection() {
+
+		_connection.disconnect();
+	}
+
+	/**
+	 * Disconnect now.
+	 *
+	 * @return true, if the connection still existed.
+	 */
+	bool disconnect() {
+
+		return _connection.disconnect();
+	}
+
+	/**
+	 * Give up the responsibility to disconnect.
+	 *
+	 * @return The plain connection handle.
+	 */
+	Connection release() {
+
+		Connection connection = _connection;
+		_connection.release();
+
+		return connection;
+	}
+
+	operator bool() const {
+
+		return _connection;
+	}
+
+private:
+
+	Connection _connection;
+};
+
+} // namespace signals
+
+#endif // SIGNALS_CONNECTION_H__
@@ -0,0 +1,341 @@
+#include <map>
+
+#include "CallbackBase.h"
+#include "ConnectionGraph.h"
+#include "Logging.h"
+#include "PassThroughCallbackBase.h"
+#include "PassThroughSlotBase.h"
+#include "Receiver.h"
+#include "Sender.h"
+#include "SlotBase.h"
+
+namespace signals {
+
+namespace {
+
+	/**
+	 * Escape a string for use in double quotes in DOT and JSON.
+	 */
+	std::string escape(const std::string& s) {
+
+		std::string escaped;
+
+		for (char c : s) {
+
+			if (c == '"' || c == '\\')
+				escaped += '\\';
+			escaped += c;
+		}
+
+		return escaped;
+	}
+
+	std::string quote(const std::string& s) {
+
+		return "\"" + escape(s) + "\"";
+	}
+}
+
+void
+ConnectionGraph::addSender(Sender& sender, const std::string& name) {
+
+	_senders.push_back(std::make_pair(&sender, name));
+}
+
+void
+ConnectionGraph::addReceiver(Receiver& receiver, const std::string& name) {
+
+	_receivers.push_back(std::make_pair(&receiver, name));
+}
+
+ConnectionGraph::Snapshot
+ConnectionGraph::snapshot() const {
+
+	Snapshot snapshot;
+
+	std::vector<SlotBase*>               slots;
+	std::vector<CallbackBase*>           callbacks;
+	std::map<SlotBase*, std::size_t>     slotIds;
+	std::map<CallbackBase*, std::size_t> callbackIds;
+
+	for (std::size_t i = 0; i < _senders.size(); i++) {
+
+		for (SlotBase* slot : _senders[i].first->getSlots()) {
+
+			SlotNode node = { i, typeName(*slot), slot->numTargets(), 0 };
+#if SIGNALS_INSTRUMENTATION
+			node.emits = slot->statistics().emits();
+#endif
+
+			slotIds[slot] = slots.size();
+			slots.push_back(slot);
+			snapshot.slots.push_back(node);
+		}
+	}
+
+	for (std::size_t i = 0; i < _receivers.size(); i++) {
+
+		for (CallbackBase* callback : _receivers[i].first->getCallbacks()) {
+
+			CallbackNode node = { i, typeName(*callback), callback->isTransparent(), 0 };
+#if SIGNALS_INSTRUMENTATION
+			node.calls = callback->statistics().count();
+#endif
+
+			callbackIds[callback] = callbacks.size();
+			callbacks.push_back(callback);
+			snapshot.callbacks.push_back(node);
+		}
+	}
+
+	for (std::size_t slotId = 0; slotId < slots.size(); slotId++) {
+
+		SlotBase* slot = slots[slotId];
+
+		for (std::size_t i = 0; i < _receivers.size(); i++) {
+
+			Receiver& receiver = *_receivers[i].first;
+
+			const Receiver::callbacks_type& candidates = receiver.getCallbacks(slot->getSignalType());
+
+			// connected callbacks first, to tell which exclusive ones are 
+			// shadowed
+			bool exclusiveConnected = false;
+			std::vector<CallbackBase*> unconnected;
+
+			for (CallbackBase* callback : candidates) {
+
+				PassThroughCallbackBase* passThrough = dynamic_cast<PassThroughCallbackBase*>(callback);
+
+				bool connected = (passThrough ? passThrough->getSlots().contains(slot) : slot->isConnected(*callback));
+
+				if (!connected) {
+
+					unconnected.push_back(callback);
+					continue;
+				}
+
+				if (!callback->isTransparent())
+					exclusiveConnected = true;
+
+				Edge edge = { Connected, slotId, callbackIds[callback] };
+				snapshot.edges.push_back(edge);
+			}
+
+			if (!exclusiveConnected)
+				continue;
+
+			for (CallbackBase* callback : unconnected) {
+
+				if (callback->isTransparent())
+					continue;
+
+				Edge edge = { Shadowed, slotId, callbackIds[callback] };
+				snapshot.edges.push_back(edge);
+			}
+		}
+
+		// pass-through slots lead to receivers
+		if (PassThroughSlotBase* passThrough = dynamic_cast<PassThroughSlotBase*>(slot))
+			for (std::size_t i = 0; i < _receivers.size(); i++)
+				if (passThrough->getReceivers().contains(_receivers[i].first)) {
+
+					Edge edge = { Tunnels, slotId, i };
+					snapshot.edges.push_back(edge);
+				}
+	}
+
+	// pass-through callbacks forward to pass-through slots
+	for (std::size_t callbackId = 0; callbackId < callbacks.size(); callbackId++) {
+
+		PassThroughCallbackBase* passThrough = dynamic_cast<PassThroughCallbackBase*>(callbacks[callbackId]);
+
+		if (!passThrough)
+			continue;
+
+		auto target = slotIds.find(&passThrough->getTarget());
+
+		if (target == slotIds.end())
+			continue;
+
+		Edge edge = { Forwards, callbackId, target->second };
+		snapshot.edges.push_back(edge);
+	}
+
+	return snapshot;
+}
+
+void
+ConnectionGraph::writeDot(std::ostream& out) const {
+
+	Snapshot graph = snapshot();
+
+	out << "digraph signals {" << std::endl;
+	out << "\tcompound=true;" << std::endl;
+	out << "\trankdir=LR;" << std::endl;
+	out << "\tnode [shape=box];" << std::endl;
+
+	for (std::size_t i = 0; i < _senders.size(); i++) {
+
+		out << "\tsubgraph cluster_sender" << i << " {" << std::endl;
+		out << "\t\tlabel=" << quote(_senders[i].second) << ";" << std::endl;
+
+		for (std::size_t j = 0; j < graph.slots.size(); j++) {
+
+			const SlotNode& slot = graph.slots[j];
+
+			if (slot.group != i)
+				continue;
+
+			std::string label = escape(slot.type) + "\\nfan-out " + std::to_string(slot.fanOut);
+#if SIGNALS_INSTRUMENTATION
+			label += "\\nemits " + std::to_string(slot.emits);
+#endif
+
+			out << "\t\tslot" << j << " [label=\"" << label << "\"];" << std::endl;
+		}
+
+		out << "\t}" << std::endl;
+	}
+
+	// the first callback of each receiver, as anchor for tunnel edges
+	std::vector<std::size_t> anchors(_receivers.size(), graph.callbacks.size());
+
+	for (std::size_t i = 0; i < _receivers.size(); i++) {
+
+		out << "\tsubgraph cluster_receiver" << i << " {" << std::endl;
+		out << "\t\tlabel=" << quote(_receivers[i].second) << ";" << std::endl;
+
+		for (std::size_t j = 0; j < graph.callbacks.size(); j++) {
+
+			const CallbackNode& callback = graph.callbacks[j];
+
+			if (callback.group != i)
+				continue;
+
+			if (anchors[i] == graph.callbacks.size())
+				anchors[i] = j;
+
+			std::string label = escape(callback.type) + (callback.transparent ? "\\ntransparent" : "");
+#if SIGNALS_INSTRUMENTATION
+			label += "\\ncalls " + std::to_string(callback.calls);
+#endif
+
+			out << "\t\tcallback" << j << " [shape=ellipse, label=\"" << label << "\"];" << std::endl;
+		}
+
+		out << "\t}" << std::endl;
+	}
+
+	for (const Edge& edge : graph.edges) {
+
+		switch (edge.kind) {
+
+			case Connected:
+				out << "\tslot" << edge.from << " -> callback" << edge.to << ";" << std::endl;
+				break;
+
+			case Shadowed:
+				out << "\tslot" << edge.from << " -> callback" << edge.to << " [style=dashed, color=gray];" << std::endl;
+				break;
+
+			case Forwards:
+				out << "\tcallback" << edge.from << " -> slot" << edge.to << " [style=dotted];" << std::endl;
+				break;
+
+			case Tunnels:
+				if (anchors[edge.to] == graph.callbacks.size())
+					break;
+				out
+						<< "\tslot" << edge.from << " -> callback" << anchors[edge.to]
+						<< " [style=dotted, lhead=cluster_receiver" << edge.to << "];" << std::endl;
+				break;
+		}
+	}
+
+	out << "}" << std::endl;
+}
+
+void
+ConnectionGraph::writeJson(std::ostream& out) const {
+
+	Snapshot graph = snapshot();
+
+	out << "{" << std::endl;
+
+	out << "  \"senders\": [";
+	for (std::size_t i = 0; i < _senders.size(); i++)
+		out << (i == 0 ? "" : ", ") << quote(_senders[i].second);
+	out << "]," << std::endl;
+
+	out << "  \"receivers\": [";
+	for (std::size_t i = 0; i < _receivers.size(); i++)
+		out << (i == 0 ? "" : ", ") << quote(_receivers[i].second);
+	out << "]," << std::endl;
+
+	out << "  \"slots\": [" << std::endl;
+	for (std::size_t i = 0; i < graph.slots.size(); i++) {
+
+		const SlotNode& slot = graph.slots[i];
+
+		out
+				<< "    {\"id\": " << i
+				<< ", \"sender\": " << slot.group
+				<< ", \"type\": " << quote(slot.type)
+				<< ", \"fan_out\": " << slot.fanOut;
+#if SIGNALS_INSTRUMENTATION
+		out << ", \"emits\": " << slot.emits;
+#endif
+		out << "}" << (i + 1 < graph.slots.size() ? "," : "") << std::endl;
+	}
+	out << "  ]," << std::endl;
+
+	out << "  \"callbacks\": [" << std::endl;
+	for (std::size_t i = 0; i < graph.callbacks.size(); i++) {
+
+		const CallbackNode& callback = graph.callbacks[i];
+
+		out
+				<< "    {\"id\": " << i
+				<< ", \"receiver\": " << callback.group
+				<< ", \"type\": " << quote(callback.type)
+				<< ", \"transparent\": " << (callback.transparent ? "true" : "false");
+#if SIGNALS_INSTRUMENTATION
+		out << ", \"calls\": " << callback.calls;
+#endif
+		out << "}" << (i + 1 < graph.callbacks.size() ? "," : "") << std::endl;
+	}
+	out << "  ]," << std::endl;
+
+	// edges refer to slots, callbacks, or receivers, depending on their kind
+	out << "  \"edges\": [" << std::endl;
+	for (std::size_t i = 0; i < graph.edges.size(); i++) {
+
+		const Edge& edge = graph.edges[i];
+
+		out
+				<< "    {\"kind\": \"" << kindName(edge.kind) << "\""
+				<< ", \"from\": " << edge.from
+				<< ", \"to\": " << edge.to
+				<< "}" << (i + 1 < graph.edges.size() ? "," : "") << std::endl;
+	}
+	out << "  ]" << std::endl;
+
+	out << "}" << std::endl;
+}
+
+const char*
+ConnectionGraph::kindName(EdgeKind kind) {
+
+	switch (kind) {
+
+		case Connected: return "connected";
+		case Shadowed:  return "shadowed";
+		case Forwards:  return "forwards";
+		case Tunnels:   return "tunnels";
+	}
+
+	return "";
+}
+
+} // namespace signals
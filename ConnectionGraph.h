@@ -0,0 +1,118 @@
+#ifndef SIGNALS_CONNECTION_GRAPH_H__
+#define SIGNALS_CONNECTION_GRAPH_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace signals {
+
+// forward declarations
+class Sender;
+class Receiver;
+
+/**
+ * Introspection of the connections between a set of senders and receivers. 
+ * The graph is read from the live objects whenever it is written: For each 
+ * slot of the senders and each compatible callback of the receivers, it shows 
+ * whether they are connected, or whether the callback is shadowed by a more 
+ * specific exclusive callback of the same receiver. Pass-through callbacks 
+ * are linked to the pass-through slots they forward to, and pass-through 
+ * slots to the receivers they lead to.
+ *
+ * Slots are annotated with their fan-out (the number of callbacks they send 
+ * to) and, with SIGNALS_INSTRUMENTATION, the number of emits. Callbacks are 
+ * annotated with the number of calls, if instrumentation is on.
+ *
+ * Usage:
+ *
+ *   ConnectionGraph graph;
+ *   graph.addSender(sender, "sender");
+ *   graph.addReceiver(receiver, "receiver");
+ *   graph.writeDot(std::cout);
+ */
+class ConnectionGraph {
+
+public:
+
+	/**
+	 * Add a sender to the graph. The sender has to outlive the graph.
+	 */
+	void addSender(Sender& sender, const std::string& name);
+
+	/**
+	 * Add a receiver to the graph. The receiver has to outlive the graph.
+	 */
+	void addReceiver(Receiver& receiver, const std::string& name);
+
+	/**
+	 * Write the graph in the DOT format of graphviz.
+	 */
+	void writeDot(std::ostream& out) const;
+
+	/**
+	 * Write the graph as JSON.
+	 */
+	void writeJson(std::ostream& out) const;
+
+private:
+
+	enum EdgeKind {
+
+		// a slot sends to a callback
+		Connected,
+
+		// a compatible callback is not connected, because a more specific 
+		// exclusive callback of the same receiver is
+		Shadowed,
+
+		// a pass-through callback forwards to a pass-through slot
+		Forwards,
+
+		// a pass-through slot leads to a receiver
+		Tunnels
+	};
+
+	struct SlotNode {
+
+		std::size_t   group;
+		std::string   type;
+		std::size_t   fanOut;
+		std::uint64_t emits;
+	};
+
+	struct CallbackNode {
+
+		std::size_t   group;
+		std::string   type;
+		bool          transparent;
+		std::uint64_t calls;
+	};
+
+	struct Edge {
+
+		EdgeKind    kind;
+		std::size_t from;
+		std::size_t to;
+	};
+
+	struct Snapshot {
+
+		std::vector<SlotNode>     slots;
+		std::vector<CallbackNode> callbacks;
+		std::vector<Edge>         edges;
+	};
+
+	Snapshot snapshot() const;
+
+	static const char* kindName(EdgeKind kind);
+
+	std::vector<std::pair<Sender*, std::string> >   _senders;
+	std::vector<std::pair<Receiver*, std::string> > _receivers;
+};
+
+} // namespace signals
+
+#endif // SIGNALS_CONNECTION_GRAPH_H__
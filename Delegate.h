@@ -0,0 +1,228 @@
+#ifndef SIGNALS_DELEGATE_H__
+#define SIGNALS_DELEGATE_H__
+
+#include <type_traits>
+#include <utility>
+
+#include "Batch.h"
+
+namespace signals {
+
+// forward declaration
+class Signal;
+
+/**
+ * Compact, copyable reference to a function accepting signals. A delegate
+ * consists of a pointer to an object, a pointer to a function (thunk) that 
+ * knows how to call the object with a signal, and a pointer to a static table 
+ * for the less frequent uses (batches of signals, read-only checks). Invoking 
+ * a delegate with a signal is therefore a single indirect call.
+ *
+ * Delegates do not own the object they refer to.
+ */
+class Delegate {
+
+public:
+
+	// pass a single signal to the object
+	typedef void (*call_type)(void* object, Signal& signal);
+
+	struct Thunks {
+
+		// pass a batch of signals to the object
+		void (*callBatch)(void* object, const SignalBatch& batch);
+
+		// true, if the object accepts signals as const references
+		bool readOnly;
+	};
+
+	/**
+	 * Create a delegate that does nothing.
+	 */
+	Delegate() :
+		_object(0),
+		_call(&noop),
+		_thunks(noopThunks()) {}
+
+	Delegate(void* object, call_type call, const Thunks* thunks) :
+		_object(object),
+		_call(call),
+		_thunks(thunks) {}
+
+	/**
+	 * Create a delegate to a functor with signature void(SignalType&). The
+	 * delegate will pass on signals as SignalType&. Batches are passed on one 
+	 * signal at a time.
+	 */
+	template <typename SignalType, typename FunctorType>
+	static Delegate fromFunctor(FunctorType& functor) {
+
+		return Delegate(
+				&functor,
+				&FunctorThunks<SignalType, FunctorType>::call,
+				&FunctorThunks<SignalType, FunctorType>::thunks);
+	}
+
+	/**
+	 * Create a delegate to a functor with signature void(const 
+	 * Batch<SignalType>&). Single signals are passed on as batches of size 
+	 * one.
+	 */
+	template <typename SignalType, typename FunctorType>
+	static Delegate fromBatchFunctor(FunctorType& functor) {
+
+		return Delegate(
+				&functor,
+				&BatchFunctorThunks<SignalType, FunctorType>::call,
+				&BatchFunctorThunks<SignalType, FunctorType>::thunks);
+	}
+
+	/**
+	 * Create a delegate to a method void (T::*Method)(SignalType&) of the
+	 * given object.
+	 */
+	template <typename SignalType, typename T, void (T::*Method)(SignalType&)>
+	static Delegate fromMethod(T& object) {
+
+		return Delegate(
+				&object,
+				&MethodThunks<SignalType, T, Method>::call,
+				&MethodThunks<SignalType, T, Method>::thunks);
+	}
+
+	/**
+	 * Pass a signal to the delegate.
+	 */
+	void operator()(Signal& signal) const {
+
+		_call(_object, signal);
+	}
+
+	/**
+	 * Pass a batch of signals to the delegate.
+	 */
+	void operator()(const SignalBatch& batch) const {
+
+		_thunks->callBatch(_object, batch);
+	}
+
+	/**
+	 * Returns true, if the delegate does not modify the signals passed to it.
+	 */
+	bool isReadOnly() const {
+
+		return _thunks->readOnly;
+	}
+
+	/**
+	 * Two delegates are equal, if they call the same function on the same 
+	 * object.
+	 */
+	bool operator==(const Delegate& other) const {
+
+		return _object == other._object && _call == other._call && _thunks == other._thunks;
+	}
+
+private:
+
+	static void noop(void*, Signal&) {}
+	static void noopBatch(void*, const SignalBatch&) {}
+
+	static const Thunks* noopThunks() {
+
+		static const Thunks thunks = { &noopBatch, true };
+		return &thunks;
+	}
+
+	/**
+	 * Tests whether a functor can be called with a const signal.
+	 */
+	template <typename SignalType, typename FunctorType>
+	struct AcceptsConst {
+
+		template <typename F>
+		static std::true_type test(decltype(std::declval<F&>()(std::declval<const SignalType&>()))*);
+
+		template <typename F>
+		static std::false_type test(...);
+
+		static const bool value = decltype(test<FunctorType>(0))::value;
+	};
+
+	template <typename SignalType, typename FunctorType>
+	struct FunctorThunks {
+
+		static void call(void* functor, Signal& signal) {
+
+			(*static_cast<FunctorType*>(functor))(static_cast<SignalType&>(signal));
+		}
+
+		static void callBatch(void* functor, const SignalBatch& batch) {
+
+			for (std::size_t i = 0; i < batch.size(); i++)
+				(*static_cast<FunctorType*>(functor))(static_cast<SignalType&>(batch[i]));
+		}
+
+		static const Thunks thunks;
+	};
+
+	template <typename SignalType, typename FunctorType>
+	struct BatchFunctorThunks {
+
+		static void call(void* functor, Signal& signal) {
+
+			SignalType* s = &static_cast<SignalType&>(signal);
+			callBatch(functor, SignalBatch(s, s + 1));
+		}
+
+		static void callBatch(void* functor, const SignalBatch& batch) {
+
+			(*static_cast<FunctorType*>(functor))(Batch<SignalType>(batch));
+		}
+
+		static const Thunks thunks;
+	};
+
+	template <typename SignalType, typename T, void (T::*Method)(SignalType&)>
+	struct MethodThunks {
+
+		static void call(void* object, Signal& signal) {
+
+			(static_cast<T*>(object)->*Method)(static_cast<SignalType&>(signal));
+		}
+
+		static void callBatch(void* object, const SignalBatch& batch) {
+
+			for (std::size_t i = 0; i < batch.size(); i++)
+				(static_cast<T*>(object)->*Method)(static_cast<SignalType&>(batch[i]));
+		}
+
+		static const Thunks thunks;
+	};
+
+	void*         _object;
+	call_type     _call;
+	const Thunks* _thunks;
+};
+
+template <typename SignalType, typename FunctorType>
+const Delegate::Thunks Delegate::FunctorThunks<SignalType, FunctorType>::thunks = {
+	&Delegate::FunctorThunks<SignalType, FunctorType>::callBatch,
+	Delegate::AcceptsConst<SignalType, FunctorType>::value
+};
+
+template <typename SignalType, typename FunctorType>
+const Delegate::Thunks Delegate::BatchFunctorThunks<SignalType, FunctorType>::thunks = {
+	&Delegate::BatchFunctorThunks<SignalType, FunctorType>::callBatch,
+	false
+};
+
+template <typename SignalType, typename T, void (T::*Method)(SignalType&)>
+const Delegate::Thunks Delegate::MethodThunks<SignalType, T, Method>::thunks = {
+	&Delegate::MethodThunks<SignalType, T, Method>::callBatch,
+	false
+};
+
+} // namespace signals
+
+#endif // SIGNALS_DELEGATE_H__
@@ -0,0 +1,290 @@
+#ifndef SIGNALS_DISPATCH_POLICY_H__
+#define SIGNALS_DISPATCH_POLICY_H__
+
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+#include <boost/atomic.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/thread.hpp>
+
+#include "ThreadPool.h"
+
+namespace signals {
+
+/**
+ * Dispatch policy for slots that deliver signals to all callbacks in the 
+ * thread that sends the signal, before the send returns.
+ */
+class Synchronous {
+
+public:
+
+	static const bool IsSynchronous = true;
+
+	template <typename SignalType>
+	class Dispatcher {
+
+	public:
+
+		template <typename SendFunction>
+		void dispatch(SignalType& signal, SendFunction send) {
+
+			send(signal);
+		}
+
+		template <typename SendFunction>
+		void dispatch(SignalType&& signal, SendFunction send) {
+
+			send(signal);
+		}
+
+		template <typename SendFunction>
+		void dispatchBatch(SignalType* first, SignalType* last, SendFunction send) {
+
+			send(first, last);
+		}
+
+		template <typename SendFunction>
+		void flush(SendFunction) {}
+
+		void wait() {}
+	};
+};
+
+/**
+ * Dispatch policy for slots that return immediately from sending. A copy of 
+ * the signal is queued in a thread pool (ThreadPool::getDefault()), where it 
+ * is delivered to the callbacks by one of the workers. Signals sent in a row 
+ * might be delivered concurrently and in a different order.
+ *
+ * Requires SignalType to be copy constructible and the slot to use the 
+ * MultiThreaded threading policy.
+ */
+class Queued {
+
+public:
+
+	static const bool IsSynchronous = false;
+
+	template <typename SignalType>
+	class Dispatcher {
+
+	public:
+
+		Dispatcher(ThreadPool& pool = ThreadPool::getDefault()) :
+			_pool(pool),
+			_numPending(0) {}
+
+		/**
+		 * Waits for all pending deliveries to finish.
+		 */
+		~Dispatcher() {
+
+			wait();
+		}
+
+		template <typename SendFunction>
+		void dispatch(SignalType& signal, SendFunction send) {
+
+			_numPending.fetch_add(1, boost::memory_order_relaxed);
+
+			_pool.post([this, signal, send]() mutable {
+
+				send(signal);
+				_numPending.fetch_sub(1, boost::memory_order_release);
+			});
+		}
+
+		/**
+		 * Queue a temporary signal. The signal is moved into the task instead 
+		 * of copied.
+		 */
+		template <typename SendFunction>
+		void dispatch(SignalType&& signal, SendFunction send) {
+
+			_numPending.fetch_add(1, boost::memory_order_relaxed);
+
+			_pool.post(std::bind([this, send](SignalType& signal) mutable {
+
+				send(signal);
+				_numPending.fetch_sub(1, boost::memory_order_release);
+
+			}, std::move(signal)));
+		}
+
+		template <typename SendFunction>
+		void dispatchBatch(SignalType* first, SignalType* last, SendFunction send) {
+
+			_numPending.fetch_add(1, boost::memory_order_relaxed);
+
+			std::shared_ptr<std::vector<SignalType> > batch = std::make_shared<std::vector<SignalType> >(first, last);
+
+			_pool.post([this, batch, send]() mutable {
+
+				send(batch->data(), batch->data() + batch->size());
+				_numPending.fetch_sub(1, boost::memory_order_release);
+			});
+		}
+
+		template <typename SendFunction>
+		void flush(SendFunction) {}
+
+		/**
+		 * Wait until all signals dispatched so far have been delivered. Helps 
+		 * the thread pool with pending tasks while waiting.
+		 */
+		void wait() {
+
+			while (_numPending.load(boost::memory_order_acquire) > 0)
+				if (!_pool.tryRunOne())
+					boost::this_thread::yield();
+		}
+
+	private:
+
+		ThreadPool& _pool;
+
+		// the number of signals that are queued or being delivered
+		boost::atomic<size_t> _numPending;
+	};
+};
+
+/**
+ * Merge function for Coalescing slots that keeps the latest signal.
+ */
+struct KeepLast {
+
+	template <typename SignalType>
+	void operator()(SignalType& pending, const SignalType& signal) const {
+
+		pending = signal;
+	}
+
+	template <typename SignalType>
+	void operator()(SignalType& pending, SignalType&& signal) const {
+
+		pending = std::move(signal);
+	}
+};
+
+/**
+ * Dispatch policy for slots that send idempotent notifications (like 
+ * "modified"). Sending only marks a copy of the signal as pending, it is 
+ * delivered once by the next Slot::flush(), see also ScopedFlush. Signals sent 
+ * while another one is pending are merged into the pending one by calling 
+ * MergeFunction()(pending, signal), which by default keeps the latest signal.
+ *
+ * Requires SignalType to be copy assignable. The pending signal is not 
+ * synchronized, sending and flushing has to happen in the same thread.
+ */
+template <typename MergeFunction = KeepLast>
+class Coalescing {
+
+public:
+
+	// delivery happens in the thread that calls flush()
+	static const bool IsSynchronous = true;
+
+	template <typename SignalType>
+	class Dispatcher {
+
+	public:
+
+		Dispatcher() :
+			_isPending(false) {}
+
+		template <typename SendFunction>
+		void dispatch(SignalType& signal, SendFunction) {
+
+			if (_isPending) {
+
+				_merge(_pending, signal);
+				return;
+			}
+
+			_pending   = signal;
+			_isPending = true;
+		}
+
+		template <typename SendFunction>
+		void dispatch(SignalType&& signal, SendFunction) {
+
+			if (_isPending) {
+
+				_merge(_pending, std::move(signal));
+				return;
+			}
+
+			_pending   = std::move(signal);
+			_isPending = true;
+		}
+
+		template <typename SendFunction>
+		void dispatchBatch(SignalType* first, SignalType* last, SendFunction send) {
+
+			for (SignalType* signal = first; signal != last; signal++)
+				dispatch(*signal, send);
+		}
+
+		/**
+		 * Deliver the pending signal, if there is one.
+		 */
+		template <typename SendFunction>
+		void flush(SendFunction send) {
+
+			if (!_isPending)
+				return;
+
+			// callbacks might send again while we deliver
+			SignalType signal(std::move(_pending));
+			_isPending = false;
+
+			send(signal);
+		}
+
+		void wait() {}
+
+	private:
+
+		SignalType    _pending;
+		bool          _isPending;
+		MergeFunction _merge;
+	};
+};
+
+/**
+ * Flushes a slot (or anything else that has a flush() method) at the end of 
+ * its scope.
+ *
+ * Usage:
+ *
+ *   {
+ *     ScopedFlush<ModifiedSlot> flush(modified);
+ *
+ *     for (...)
+ *       modified(); // delivered once, at the end of the scope
+ *   }
+ */
+template <typename FlushableType>
+class ScopedFlush : public boost::noncopyable {
+
+public:
+
+	ScopedFlush(FlushableType& flushable) :
+		_flushable(flushable) {}
+
+	~ScopedFlush() {
+
+		_flushable.flush();
+	}
+
+private:
+
+	FlushableType& _flushable;
+};
+
+} // namespace signals
+
+#endif // SIGNALS_DISPATCH_POLICY_H__
@@ -0,0 +1,247 @@
+#include <deque>
+#include <limits>
+#include <memory>
+#include <new>
+#include <vector>
+#include <boost/align/aligned_alloc.hpp>
+#include <boost/thread.hpp>
+
+#include "Epochs.h"
+
+namespace signals {
+
+namespace {
+
+	const std::size_t CacheLineSize = 64;
+}
+
+/**
+ * Records are written by their thread on every send. Each record gets its own 
+ * cache line, such that senders in different threads don't contend.
+ */
+struct alignas(CacheLineSize) Epochs::Record {
+
+	Record() :
+		epoch(0),
+		nesting(0),
+		leaves(0),
+		inUse(true) {}
+
+	// the epoch announced by the owning thread, 0 if outside of a guard
+	boost::atomic<std::uint64_t> epoch;
+
+	// number of nested guards, only accessed by the owning thread
+	unsigned int nesting;
+
+	// number of outermost guards left, only accessed by the owning thread
+	unsigned int leaves;
+
+	// false, if the owning thread terminated and the record can be reused
+	boost::atomic<bool> inUse;
+
+	// plain new does not have to respect the alignment before C++17
+	static void* operator new(std::size_t size) {
+
+		void* p = boost::alignment::aligned_alloc(CacheLineSize, size);
+
+		if (!p)
+			throw std::bad_alloc();
+
+		return p;
+	}
+
+	static void operator delete(void* p) {
+
+		boost::alignment::aligned_free(p);
+	}
+};
+
+static_assert(
+		sizeof(Epochs::Record) == CacheLineSize,
+		"epoch records should fill exactly one cache line");
+
+namespace {
+
+	// Leaving the outermost guard tries to collect retired objects only every 
+	// CollectInterval-th time. Collecting takes the global mutex and scans 
+	// all records, sends should not do that while objects are pending.
+	const unsigned int CollectInterval = 64;
+
+	struct Retired {
+
+		std::uint64_t         epoch;
+		Epochs::deleter_type  deleter;
+	};
+
+	struct State {
+
+		State() :
+			epoch(1),
+			numRetired(0) {}
+
+		// the global epoch, advanced by every retire
+		boost::atomic<std::uint64_t> epoch;
+
+		boost::atomic<std::size_t> numRetired;
+
+		// guards records and retired
+		boost::mutex mutex;
+
+		std::vector<std::unique_ptr<Epochs::Record> > records;
+
+		// retired objects, ordered by epoch
+		std::deque<Retired> retired;
+	};
+
+	State& state() {
+
+		// never destructed, threads might still leave guards during static 
+		// destruction
+		static State* state = new State();
+
+		return *state;
+	}
+
+	/**
+	 * Releases the record of a thread when the thread terminates.
+	 */
+	struct ThreadRecord {
+
+		ThreadRecord() :
+			record(0) {}
+
+		~ThreadRecord() {
+
+			if (record)
+				record->inUse.store(false, boost::memory_order_release);
+		}
+
+		Epochs::Record* record;
+	};
+
+	thread_local ThreadRecord threadRecord;
+
+	Epochs::Record*
+	createRecord() {
+
+		State& s = state();
+
+		boost::mutex::scoped_lock lock(s.mutex);
+
+		for (auto& record : s.records)
+			if (!record->inUse.load(boost::memory_order_acquire)) {
+
+				record->inUse.store(true, boost::memory_order_relaxed);
+				return record.get();
+			}
+
+		s.records.emplace_back(new Epochs::Record());
+
+		return s.records.back().get();
+	}
+}
+
+Epochs::Record*
+Epochs::enter() {
+
+	Record* record = threadRecord.record;
+
+	if (!record)
+		record = threadRecord.record = createRecord();
+
+	if (record->nesting++ == 0) {
+
+		// announcing a stale epoch is safe, it only delays reclamation
+		record->epoch.store(state().epoch.load(boost::memory_order_acquire), boost::memory_order_relaxed);
+
+		// make the announcement visible before the guarded object is checked 
+		// for liveness, pairs with the fence in retire()
+		boost::atomic_thread_fence(boost::memory_order_seq_cst);
+	}
+
+	return record;
+}
+
+void
+Epochs::leave(Record* record) {
+
+	if (--record->nesting > 0)
+		return;
+
+	record->epoch.store(0, boost::memory_order_release);
+
+	if (++record->leaves % CollectInterval != 0)
+		return;
+
+	if (state().numRetired.load(boost::memory_order_relaxed) > 0)
+		collect();
+}
+
+void
+Epochs::retire(deleter_type deleter) {
+
+	State& s = state();
+
+	// the object was marked dead before, make sure every thread that enters 
+	// a guard from now on sees it
+	boost::atomic_thread_fence(boost::memory_order_seq_cst);
+
+	{
+		boost::mutex::scoped_lock lock(s.mutex);
+
+		Retired retired;
+		retired.epoch   = s.epoch.fetch_add(1, boost::memory_order_acq_rel);
+		retired.deleter = std::move(deleter);
+
+		s.retired.push_back(std::move(retired));
+		s.numRetired.fetch_add(1, boost::memory_order_relaxed);
+	}
+
+	collect();
+}
+
+std::size_t
+Epochs::collect() {
+
+	State& s = state();
+
+	std::vector<deleter_type> ready;
+
+	{
+		boost::unique_lock<boost::mutex> lock(s.mutex, boost::try_to_lock);
+
+		// someone else is collecting
+		if (!lock)
+			return s.numRetired.load(boost::memory_order_relaxed);
+
+		boost::atomic_thread_fence(boost::memory_order_seq_cst);
+
+		// the oldest epoch a thread inside a guard might have seen
+		std::uint64_t oldest = std::numeric_limits<std::uint64_t>::max();
+
+		for (auto& record : s.records) {
+
+			std::uint64_t epoch = record->epoch.load(boost::memory_order_acquire);
+
+			if (epoch != 0 && epoch < oldest)
+				oldest = epoch;
+		}
+
+		// objects retired before that epoch can not be in use anymore
+		while (!s.retired.empty() && s.retired.front().epoch < oldest) {
+
+			ready.push_back(std::move(s.retired.front().deleter));
+			s.retired.pop_front();
+		}
+
+		s.numRetired.fetch_sub(ready.size(), boost::memory_order_relaxed);
+	}
+
+	// deleters might retire other objects
+	for (auto& deleter : ready)
+		deleter();
+
+	return s.numRetired.load(boost::memory_order_relaxed);
+}
+
+} // namespace signals
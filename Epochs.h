@@ -0,0 +1,184 @@
+#ifndef SIGNALS_EPOCHS_H__
+#define SIGNALS_EPOCHS_H__
+
+#include <cstdint>
+#include <functional>
+#include <boost/atomic.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+
+namespace signals {
+
+/**
+ * Epoch-based reclamation of objects that might still be used by concurrent 
+ * senders. Threads that use such objects do so inside a Guard, which only 
+ * publishes the current epoch in a per-thread record. Objects are retired 
+ * instead of deleted: their deleter runs once every thread that might have 
+ * seen the object has left its guard. While retired objects are pending, 
+ * every 64th outermost guard a thread leaves tries to collect them, which is 
+ * the only time a guard writes to memory shared with other threads.
+ *
+ * Used by EpochTracking and EpochPtr.
+ */
+class Epochs {
+
+public:
+
+	typedef std::function<void()> deleter_type;
+
+	// per-thread epoch record, defined in Epochs.cpp
+	struct Record;
+
+	/**
+	 * Marks the calling thread as using retirable objects for the lifetime of 
+	 * the guard. Guards can be nested.
+	 */
+	class Guard : public boost::noncopyable {
+
+	public:
+
+		Guard() :
+			_record(enter()) {}
+
+		/**
+		 * Create a guard that enters only if active is true.
+		 */
+		explicit Guard(bool active) :
+			_record(active ? enter() : 0) {}
+
+		Guard(Guard&& other) :
+			_record(other._record) {
+
+			other._record = 0;
+		}
+
+		~Guard() {
+
+			if (_record)
+				leave(_record);
+		}
+
+	private:
+
+		Record* _record;
+	};
+
+	/**
+	 * Defer the given deleter until all threads that are currently inside a 
+	 * guard have left it.
+	 */
+	static void retire(deleter_type deleter);
+
+	/**
+	 * Run the deleters of retired objects that are not in use anymore. Called 
+	 * automatically by retire() and periodically when the outermost guard of 
+	 * a thread is left.
+	 *
+	 * @return The number of deleters that are still pending.
+	 */
+	static std::size_t collect();
+
+private:
+
+	static Record* enter();
+
+	static void leave(Record* record);
+};
+
+/**
+ * Liveness flag of an object that is owned by an EpochPtr. Shared with the 
+ * slots that track the object, it outlives the object itself.
+ */
+class EpochLifetime : public boost::noncopyable {
+
+public:
+
+	EpochLifetime() :
+		_alive(true) {}
+
+	/**
+	 * Check whether the object is still alive. Has to be called inside an 
+	 * Epochs::Guard, which keeps a live object from being deleted until the 
+	 * guard is left.
+	 */
+	bool alive() const {
+
+		return _alive.load(boost::memory_order_acquire);
+	}
+
+	void kill() {
+
+		_alive.store(false, boost::memory_order_release);
+	}
+
+private:
+
+	boost::atomic<bool> _alive;
+};
+
+/**
+ * Unique owner of an object that is tracked by callbacks with EpochTracking. 
+ * Resetting or destructing the pointer does not delete the object 
+ * immediately, but marks it dead and retires it, such that sends that are in 
+ * progress in other threads can finish.
+ */
+template <typename T>
+class EpochPtr : public boost::noncopyable {
+
+public:
+
+	explicit EpochPtr(T* object = 0) :
+		_object(0) {
+
+		reset(object);
+	}
+
+	~EpochPtr() {
+
+		reset();
+	}
+
+	/**
+	 * Retire the current object (if any) and take ownership of the given one.
+	 */
+	void reset(T* object = 0) {
+
+		if (_object) {
+
+			_lifetime->kill();
+
+			T* retired = _object;
+			Epochs::retire([retired]{ delete retired; });
+		}
+
+		_object   = object;
+		_lifetime = (object ? boost::make_shared<EpochLifetime>() : boost::shared_ptr<EpochLifetime>());
+	}
+
+	T* get() const { return _object; }
+
+	T* operator->() const { return _object; }
+
+	T& operator*() const { return *_object; }
+
+	explicit operator bool() const { return _object != 0; }
+
+	/**
+	 * Get the liveness flag of the current object.
+	 */
+	const boost::shared_ptr<EpochLifetime>& lifetime() const {
+
+		return _lifetime;
+	}
+
+private:
+
+	T* _object;
+
+	boost::shared_ptr<EpochLifetime> _lifetime;
+};
+
+} // namespace signals
+
+#endif // SIGNALS_EPOCHS_H__
@@ -0,0 +1,146 @@
+#include <algorithm>
+#include <ostream>
+#include <utility>
+#include <boost/thread/mutex.hpp>
+#include <boost/core/demangle.hpp>
+
+#include "CallbackBase.h"
+#include "Instrumentation.h"
+#include "SlotBase.h"
+
+namespace signals {
+
+// the symbol of the setting this library was compiled with, see 
+// Instrumentation.h
+#if SIGNALS_INSTRUMENTATION
+const int instrumentationEnabled = 1;
+#else
+const int instrumentationDisabled = 0;
+#endif
+
+namespace {
+
+	struct Registry {
+
+		boost::mutex mutex;
+
+		// registered objects with the mangled type names of their most 
+		// derived classes
+		std::vector<std::pair<const SlotBase*, const char*>>     slots;
+		std::vector<std::pair<const CallbackBase*, const char*>> callbacks;
+	};
+
+	Registry& registry() {
+
+		static Registry registry;
+		return registry;
+	}
+
+	template <typename T>
+	void erase(std::vector<std::pair<const T*, const char*>>& v, const T* p) {
+
+		auto i = std::find_if(v.begin(), v.end(), [p](const std::pair<const T*, const char*>& e){ return e.first == p; });
+		if (i != v.end()) {
+
+			*i = v.back();
+			v.pop_back();
+		}
+	}
+
+	std::string demangle(const char* name, const char* fallback) {
+
+		return (name ? boost::core::demangle(name) : std::string(fallback));
+	}
+}
+
+void
+Instrumentation::registerSlot(const SlotBase& slot, const char* name) {
+
+	boost::mutex::scoped_lock lock(registry().mutex);
+	registry().slots.push_back(std::make_pair(&slot, name));
+}
+
+void
+Instrumentation::unregisterSlot(const SlotBase& slot) {
+
+	boost::mutex::scoped_lock lock(registry().mutex);
+	erase(registry().slots, &slot);
+}
+
+void
+Instrumentation::registerCallback(const CallbackBase& callback, const char* name) {
+
+	boost::mutex::scoped_lock lock(registry().mutex);
+	registry().callbacks.push_back(std::make_pair(&callback, name));
+}
+
+void
+Instrumentation::unregisterCallback(const CallbackBase& callback) {
+
+	boost::mutex::scoped_lock lock(registry().mutex);
+	erase(registry().callbacks, &callback);
+}
+
+Instrumentation::Snapshot
+Instrumentation::snapshot() {
+
+	Snapshot snapshot;
+
+	boost::mutex::scoped_lock lock(registry().mutex);
+
+#if SIGNALS_INSTRUMENTATION
+	for (const auto& entry : registry().slots) {
+
+		const SlotStatistics& statistics = entry.first->statistics();
+
+		SlotSnapshot s = {
+			entry.first,
+			demangle(entry.second, "SlotBase"),
+			statistics.emits(),
+			statistics.targets(),
+			statistics.staleRemoved()
+		};
+		snapshot.slots.push_back(s);
+	}
+
+	for (const auto& entry : registry().callbacks) {
+
+		const CallbackStatistics& statistics = entry.first->statistics();
+
+		CallbackSnapshot c = { entry.first, demangle(entry.second, "CallbackBase"), std::vector<std::uint64_t>() };
+		for (unsigned int i = 0; i < CallbackStatistics::NumBuckets; i++)
+			c.buckets.push_back(statistics.bucket(i));
+		snapshot.callbacks.push_back(c);
+	}
+#endif
+
+	return snapshot;
+}
+
+void
+Instrumentation::dump(std::ostream& out) {
+
+	Snapshot s = snapshot();
+
+	std::sort(s.slots.begin(), s.slots.end(), [](const SlotSnapshot& a, const SlotSnapshot& b){ return a.emits > b.emits; });
+
+	out << "slots (by number of emits):" << std::endl;
+	for (const SlotSnapshot& slot : s.slots)
+		out
+				<< "  " << slot.name << " (" << slot.slot << "): "
+				<< slot.emits << " emits, "
+				<< slot.targets << " targets, "
+				<< slot.staleRemoved << " stale removed" << std::endl;
+
+	out << "callbacks (latency histogram, bucket upper bound in ns: count):" << std::endl;
+	for (const CallbackSnapshot& callback : s.callbacks) {
+
+		out << "  " << callback.name << " (" << callback.callback << "):";
+		for (unsigned int i = 0; i < callback.buckets.size(); i++)
+			if (callback.buckets[i] > 0)
+				out << " " << (std::uint64_t(1) << i) << ": " << callback.buckets[i];
+		out << std::endl;
+	}
+}
+
+} // namespace signals
@@ -0,0 +1,179 @@
+#ifndef SIGNALS_INSTRUMENTATION_H__
+#define SIGNALS_INSTRUMENTATION_H__
+
+/**
+ * Dispatch instrumentation. Compiled out unless SIGNALS_INSTRUMENTATION is
+ * defined to 1 (see the CMake option of the same name). If enabled, every slot
+ * counts its emits, invoked targets, and removed stale invokers, and every
+ * callback records the latency of its invocations in a log-bucketed histogram.
+ * All slots and callbacks alive can be dumped or snapshot via
+ * Instrumentation.
+ */
+#ifndef SIGNALS_INSTRUMENTATION
+#define SIGNALS_INSTRUMENTATION 0
+#endif
+
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+#include <boost/atomic.hpp>
+
+namespace signals {
+
+// forward declarations
+class SlotBase;
+class CallbackBase;
+
+/**
+ * Counters of a slot.
+ */
+class SlotStatistics {
+
+public:
+
+	SlotStatistics() :
+		_emits(0),
+		_targets(0),
+		_staleRemoved(0) {}
+
+	void recordEmit(std::uint64_t numTargets) {
+
+		_emits.fetch_add(1, boost::memory_order_relaxed);
+		_targets.fetch_add(numTargets, boost::memory_order_relaxed);
+	}
+
+	void recordStaleRemoved(std::uint64_t numRemoved = 1) {
+
+		_staleRemoved.fetch_add(numRemoved, boost::memory_order_relaxed);
+	}
+
+	std::uint64_t emits() const { return _emits.load(boost::memory_order_relaxed); }
+	std::uint64_t targets() const { return _targets.load(boost::memory_order_relaxed); }
+	std::uint64_t staleRemoved() const { return _staleRemoved.load(boost::memory_order_relaxed); }
+
+private:
+
+	boost::atomic<std::uint64_t> _emits;
+	boost::atomic<std::uint64_t> _targets;
+	boost::atomic<std::uint64_t> _staleRemoved;
+};
+
+/**
+ * Latency histogram of a callback. Bucket i counts invocations that took
+ * between 2^(i-1) and 2^i nanoseconds (bucket 0 counts invocations below
+ * 1ns).
+ */
+class CallbackStatistics {
+
+public:
+
+	static const unsigned int NumBuckets = 40;
+
+	CallbackStatistics() {
+
+		for (auto& bucket : _buckets)
+			bucket.store(0, boost::memory_order_relaxed);
+	}
+
+	void recordLatency(std::uint64_t nanoseconds) {
+
+		unsigned int bucket = 0;
+		while (nanoseconds > 0 && bucket < NumBuckets - 1) {
+
+			nanoseconds >>= 1;
+			bucket++;
+		}
+
+		_buckets[bucket].fetch_add(1, boost::memory_order_relaxed);
+	}
+
+	std::uint64_t bucket(unsigned int i) const { return _buckets[i].load(boost::memory_order_relaxed); }
+
+	/**
+	 * The total number of recorded invocations.
+	 */
+	std::uint64_t count() const {
+
+		std::uint64_t total = 0;
+		for (unsigned int i = 0; i < NumBuckets; i++)
+			total += bucket(i);
+
+		return total;
+	}
+
+private:
+
+	boost::atomic<std::uint64_t> _buckets[NumBuckets];
+};
+
+/**
+ * Registry of the statistics of all slots and callbacks alive.
+ */
+class Instrumentation {
+
+public:
+
+	struct SlotSnapshot {
+
+		const SlotBase* slot;
+		std::string     name;
+		std::uint64_t   emits;
+		std::uint64_t   targets;
+		std::uint64_t   staleRemoved;
+	};
+
+	struct CallbackSnapshot {
+
+		const CallbackBase*        callback;
+		std::string                name;
+		std::vector<std::uint64_t> buckets;
+	};
+
+	struct Snapshot {
+
+		std::vector<SlotSnapshot>     slots;
+		std::vector<CallbackSnapshot> callbacks;
+	};
+
+	/**
+	 * Register a slot or callback. The name is the mangled type name of the 
+	 * most derived class, passed down from its constructor. Snapshots never 
+	 * look at the dynamic type of registered objects, since they might be 
+	 * under construction or destruction in another thread.
+	 */
+	static void registerSlot(const SlotBase& slot, const char* name);
+	static void unregisterSlot(const SlotBase& slot);
+	static void registerCallback(const CallbackBase& callback, const char* name);
+	static void unregisterCallback(const CallbackBase& callback);
+
+	/**
+	 * Copy the statistics of all registered slots and callbacks. No slot or
+	 * callback can be registered or unregistered while the snapshot is taken.
+	 */
+	static Snapshot snapshot();
+
+	/**
+	 * Write a human readable summary of a snapshot to the given stream.
+	 */
+	static void dump(std::ostream& out);
+};
+
+/*
+ * SIGNALS_INSTRUMENTATION changes the layout of slots and callbacks, the 
+ * library and everything that includes its headers have to agree on it. Each 
+ * translation unit references a symbol for its setting, which is only defined 
+ * by the library for the setting it was compiled with. A mismatch fails to 
+ * link instead of corrupting memory.
+ */
+#if SIGNALS_INSTRUMENTATION
+extern const int instrumentationEnabled;
+__attribute__((used)) static const int* const instrumentationCheck = &instrumentationEnabled;
+#else
+extern const int instrumentationDisabled;
+__attribute__((used)) static const int* const instrumentationCheck = &instrumentationDisabled;
+#endif
+
+} // namespace signals
+
+#endif // SIGNALS_INSTRUMENTATION_H__
@@ -4,5 +4,6 @@ namespace signals {
 
 	logger::LogChannel signalslog("signalslog", "[signals] ");
 
-} // namespace signals
+	boost::atomic<trace_hook_type> traceHook(0);
 
+} // namespace signals
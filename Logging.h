@@ -3,12 +3,72 @@
 
 #include <util/Logger.h>
 #include <util/typename.h>
+#include <boost/atomic.hpp>
+
+/**
+ * Compile-time log level of the signals module:
+ *
+ *   0  no logging
+ *   1  log connections and disconnections (default)
+ *   2  additionally log every signal sent
+ *
+ * Log statements above this level compile to nothing, regardless of the 
+ * run-time level of signalslog. For debugging sends without recompiling, see 
+ * setTraceHook().
+ */
+#ifndef SIGNALS_LOG_LEVEL
+#define SIGNALS_LOG_LEVEL 1
+#endif
+
+// never executed, but keeps the log statement well-formed without leaving an 
+// open else behind
+#define SIGNALS_LOG_DISABLED(channel) while (false) LOG_ALL(channel)
+
+#if SIGNALS_LOG_LEVEL >= 1
+#define SIGNALS_LOG_CONNECTIONS(channel) LOG_ALL(channel)
+#else
+#define SIGNALS_LOG_CONNECTIONS(channel) SIGNALS_LOG_DISABLED(channel)
+#endif
+
+#if SIGNALS_LOG_LEVEL >= 2
+#define SIGNALS_LOG_SENDS(channel) LOG_ALL(channel)
+#else
+#define SIGNALS_LOG_SENDS(channel) SIGNALS_LOG_DISABLED(channel)
+#endif
 
 namespace signals {
 
+// forward declarations
+class SlotBase;
+class Signal;
+
 extern logger::LogChannel signalslog;
 
+/**
+ * Function to be called for every signal that is sent.
+ */
+typedef void (*trace_hook_type)(const SlotBase& slot, const Signal& signal);
+
+extern boost::atomic<trace_hook_type> traceHook;
+
+/**
+ * Set a function to be called for every signal sent by any slot, or 0 to 
+ * disable tracing. The hook is called in the sending thread, before the 
+ * signal is dispatched.
+ */
+inline void setTraceHook(trace_hook_type hook) {
+
+	traceHook.store(hook, boost::memory_order_release);
+}
+
+/**
+ * Get the current trace hook, or 0 if tracing is disabled.
+ */
+inline trace_hook_type getTraceHook() {
+
+	return traceHook.load(boost::memory_order_acquire);
+}
+
 } // namespace signals
 
 #endif // SIGNALS_LOGGING_H__
-
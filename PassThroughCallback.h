@@ -1,6 +1,8 @@
 #ifndef SIGNALS_PASS_TROUGH_CALLBACK_H__
 #define SIGNALS_PASS_TROUGH_CALLBACK_H__
 
+#include <typeinfo>
+
 #include "Slot.h"
 #include "SignalTraits.h"
 #include "CallbackBase.h"
@@ -14,7 +16,8 @@ class PassThroughCallback : public PassThroughCallbackBase {
 
 public:
 
-	PassThroughCallback() {
+	PassThroughCallback() :
+		PassThroughCallbackBase(SignalTraits<SignalType>::id(), typeid(PassThroughCallback).name()) {
 
 		// pass through callbacks should always be connected to, even if more 
 		// specific callbacks are registered in the same receiver
@@ -26,7 +29,8 @@ public:
 	 * given slot type can be cast into the one we shall pass through. If so, it 
 	 * connects the slot with all receivers that have been connected to our 
 	 * other side (a PassThroughSlot) and keeps a pointer to slot for future 
-	 * connections on the other side.
+	 * connections on the other side. Connecting a slot that is connected 
+	 * already does nothing.
 	 *
 	 * @return
 	 *         true, if the callback and slot are type compatible.
@@ -34,11 +38,12 @@ public:
 	bool connect(SlotBase& slot) {
 
 		// check if slot's signal should be passed through
-		if (!accepts(slot.createSignal()))
+		if (!accepts(slot.getSignalType()))
 			return false;
 
 		// remember this slot for future connections on the other side
-		addSlot(slot);
+		if (!addSlot(slot))
+			return true;
 
 		// connect the new slot to each registered receiver on the other side
 		typename PassThroughSlotBase::receivers_type::iterator receiver;
@@ -53,12 +58,12 @@ public:
 	 * stored pointer to it.
 	 *
 	 * @return
-	 *         true, if the callback and slot are type compatible and have been 
-	 *         disconnected.
+	 *         true, if the slot was connected to this callback.
 	 */
 	bool disconnect(SlotBase& slot) {
 
-		removeSlot(slot);
+		if (!removeSlot(slot))
+			return false;
 
 		// disconnect this slot from each registered receiver on the other side
 		typename PassThroughSlotBase::receivers_type::iterator receiver;
@@ -79,15 +84,6 @@ public:
 
 private:
 
-	/**
-	 * Return true if this callback can accept the provided signal, i.e., if the 
-	 * signal's type is equal to or a superclass of SignalType.
-	 */
-	bool accepts(const Signal& signal) const {
-
-		return dynamic_cast<const SignalType*>(&signal);
-	}
-
 	const Signal& createSignal() const {
 
 		return SignalTraits<SignalType>::Reference;
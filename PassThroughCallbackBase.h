@@ -1,8 +1,8 @@
 #ifndef SIGNALS_PASS_THROUGH_CALLBACK_BASE_H__
 #define SIGNALS_PASS_THROUGH_CALLBACK_BASE_H__
 
-#include <set>
 #include "CallbackBase.h"
+#include "RouteTable.h"
 #include "SlotBase.h"
 
 namespace signals {
@@ -14,29 +14,38 @@ class PassThroughCallbackBase : public CallbackBase {
 
 public:
 
-	PassThroughCallbackBase() :
-		CallbackBase([](Signal&){}),
+	PassThroughCallbackBase(SignalTypeId signalType, const char* name = 0) :
+		CallbackBase(signalType, name),
 		_target(0) {}
 
-	typedef std::set<SlotBase*> slots_type;
+	typedef RouteTable<SlotBase> slots_type;
 
 	/**
-	 * Get all slots that are registered to this callback. This set is needed  
-	 * by the PassThroughSlot at the other side to establish connections.
+	 * Get all slots that are registered to this callback. These are always 
+	 * real slots: Slots that reach this callback through other tunnels are 
+	 * connected directly. This table is needed by the PassThroughSlot at the 
+	 * other side to establish connections.
 	 */
-	std::set<SlotBase*>& getSlots() {
+	slots_type& getSlots() {
 
 		return _slots;
 	}
 
+	/**
+	 * Get the other end of this pass-through tunnel.
+	 */
+	PassThroughSlotBase& getTarget() { return *_target; }
+
 protected:
 
 	/**
 	 * Add a slot to this PassThroughCallback for future connections.
+	 *
+	 * @return false, if the slot was added already.
 	 */
-	void addSlot(SlotBase& slot) {
+	bool addSlot(SlotBase& slot) {
 
-		_slots.insert(&slot);
+		return _slots.insert(&slot);
 	}
 
 	/**
@@ -52,8 +61,6 @@ protected:
 		_target = &target;
 	}
 
-	PassThroughSlotBase& getTarget() { return *_target; }
-
 private:
 
 	slots_type _slots;
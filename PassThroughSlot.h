@@ -1,6 +1,8 @@
 #ifndef SIGNALS_PASS_THROUGH_SLOT_H__
 #define SIGNALS_PASS_THROUGH_SLOT_H__
 
+#include <typeinfo>
+
 #include "SignalTraits.h"
 #include "PassThroughSlotBase.h"
 #include "PassThroughCallbackBase.h"
@@ -12,6 +14,9 @@ class PassThroughSlot : public PassThroughSlotBase {
 
 public:
 
+	PassThroughSlot() :
+		PassThroughSlotBase(SignalTraits<SignalType>::id(), typeid(PassThroughSlot).name()) {}
+
 	/**
 	 * Create a reference signal of this slot.
 	 */
@@ -23,12 +28,14 @@ public:
 	/**
 	 * Connect this slot to the given receiver. This will keep a pointer to the 
 	 * receiver for future reference and connect every source at the other side 
-	 * (a PassThroughCallback) with every currently connected receiver.
+	 * (a PassThroughCallback) with the receiver. Connecting a receiver that is 
+	 * connected already does nothing.
 	 */
 	bool connect(Receiver& receiver) {
 
 		// remember this receiver
-		addReceiver(receiver);
+		if (!addReceiver(receiver))
+			return true;
 
 		// connect all registered slots at the other side to the new receiver
 		typename PassThroughCallbackBase::slots_type::iterator slot;
@@ -44,7 +51,8 @@ public:
 	 */
 	bool disconnect(Receiver& receiver) {
 
-		removeReceiver(receiver);
+		if (!removeReceiver(receiver))
+			return false;
 
 		// disconnect all registered slots at the other side from this receiver
 		typename PassThroughCallbackBase::slots_type::iterator slot;
@@ -53,21 +61,6 @@ public:
 
 		return true;
 	}
-
-private:
-
-	void setSource(PassThroughCallbackBase& source) {
-
-		_source = &source;
-	}
-
-	bool canSend(const Signal& signal) const {
-
-		return dynamic_cast<const SignalType*>(&signal);
-	}
-
-	// all receivers that are connected to this slot
-	std::set<Receiver*> _receivers;
 };
 
 } // namespace signals
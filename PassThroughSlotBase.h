@@ -1,8 +1,8 @@
 #ifndef SIGNALS_PASS_THROUGH_SLOT_BASE_H__
 #define SIGNALS_PASS_THROUGH_SLOT_BASE_H__
 
-#include <set>
 #include "Receiver.h"
+#include "RouteTable.h"
 #include "SlotBase.h"
 
 namespace signals {
@@ -14,16 +14,18 @@ class PassThroughSlotBase : public SlotBase {
 
 public:
 
-	PassThroughSlotBase() :
+	PassThroughSlotBase(SignalTypeId signalType, const char* name = 0) :
+		SlotBase(signalType, name),
 		_source(0) {}
 
-	typedef std::set<Receiver*> receivers_type;
+	typedef RouteTable<Receiver> receivers_type;
 
 	/**
-	 * Get all recievers that are registered to this receiver. This set is needed  
-	 * by the PassThroughCallback at the other side to establish connections.
+	 * Get all recievers that are registered to this receiver. This table is 
+	 * needed by the PassThroughCallback at the other side to establish 
+	 * connections.
 	 */
-	std::set<Receiver*>& getReceivers() {
+	receivers_type& getReceivers() {
 
 		return _receivers;
 	}
@@ -48,6 +50,11 @@ public:
 	 */
 	bool removeCallback(CallbackBase&) override { return false; }
 
+	/**
+	 * The number of receivers this slot forwards to.
+	 */
+	size_t numTargets() const override { return _receivers.size(); }
+
 protected:
 
 	/**
@@ -57,10 +64,12 @@ protected:
 
 	/**
 	 * Add a receiver to this PassThroughSlot for future connections.
+	 *
+	 * @return false, if the receiver was added already.
 	 */
-	void addReceiver(Receiver& receiver) {
+	bool addReceiver(Receiver& receiver) {
 
-		_receivers.insert(&receiver);
+		return _receivers.insert(&receiver);
 	}
 
 	/**
@@ -0,0 +1,44 @@
+#ifndef SIGNALS_PAYLOAD_SIGNAL_H__
+#define SIGNALS_PAYLOAD_SIGNAL_H__
+
+#include <type_traits>
+
+#include "Signal.h"
+
+namespace signals {
+
+/**
+ * Base class for signals that carry all their data in a trivially copyable 
+ * payload. Signals themselves are polymorphic and can not be copied bytewise, 
+ * their payload can. This allows to send them between processes, see 
+ * SharedMemorySlot.
+ *
+ * Usage:
+ *
+ *   struct Position { double x, y; };
+ *
+ *   class Moved : public PayloadSignal<Position> {};
+ */
+template <typename PayloadType>
+class PayloadSignal : public Signal {
+
+	static_assert(
+			std::is_trivially_copyable<PayloadType>::value,
+			"payloads have to be trivially copyable");
+
+public:
+
+	typedef PayloadType payload_type;
+
+	PayloadSignal() :
+		payload() {}
+
+	PayloadSignal(const PayloadType& payload_) :
+		payload(payload_) {}
+
+	PayloadType payload;
+};
+
+} // namespace signals
+
+#endif // SIGNALS_PAYLOAD_SIGNAL_H__
@@ -1,9 +1,16 @@
 #ifndef SIGNALS_RECEIVER_H__
 #define SIGNALS_RECEIVER_H__
 
+#include <algorithm>
+#include <boost/make_shared.hpp>
+#include <cstdint>
+#include <map>
+#include <utility>
 #include <vector>
 #include "CallbackBase.h"
 #include "CallbackComparator.h"
+#include "ReceiverAffinity.h"
+#include "SignalTypes.h"
 
 namespace signals {
 
@@ -11,10 +18,18 @@ class Receiver {
 
 public:
 
-	typedef std::list<CallbackBase*> callbacks_type;
+	typedef std::vector<CallbackBase*> callbacks_type;
+
+	Receiver() :
+		_numSignalTypes(0) {}
 
 	~Receiver() {
 
+		// queued tasks of the affinity might outlive us, make sure they don't 
+		// call our callbacks anymore
+		if (_affinity)
+			_affinity->close();
+
 		for (auto* callback : _own)
 			delete callback;
 	}
@@ -24,13 +39,7 @@ public:
 	 */
 	void registerCallback(CallbackBase& callback) {
 
-		// make sure that transparent callbacks or callbacks of the same 
-		// specificity are called in the reverse order in which they have been 
-		// added
-		callback.setPrecendence(_callbacks.size());
-
-		_callbacks.push_back(&callback);
-		_callbacks.sort(CallbackComparator());
+		insert(&callback);
 	}
 
 	/**
@@ -38,14 +47,73 @@ public:
 	 */
 	void registerCallback(CallbackBase* callback) {
 
-		// make sure that transparent callbacks or callbacks of the same 
-		// specificity are called in the reverse order in which they have been 
-		// added
-		callback->setPrecendence(_callbacks.size());
-
-		_callbacks.push_back(callback);
 		_own.push_back(callback);
-		_callbacks.sort(CallbackComparator());
+		insert(callback);
+	}
+
+	/**
+	 * Add several callbacks to this receiver, keep ownership. Sorts the 
+	 * callbacks only once.
+	 *
+	 * @param begin, end
+	 *              A range of CallbackBase pointers.
+	 */
+	template <typename Iterator>
+	void registerCallbacks(Iterator begin, Iterator end) {
+
+		for (Iterator i = begin; i != end; ++i) {
+
+			CallbackBase* callback = *i;
+
+			callback->setPrecendence(_callbacks.size());
+			callback->setAffinity(_affinity);
+			_callbacks.push_back(callback);
+		}
+
+		sort();
+	}
+
+	/**
+	 * Bind the callbacks of this receiver to the thread of an executor, which 
+	 * has to be the calling thread. Signals sent from other threads will be 
+	 * delivered in this thread, by tasks posted to the executor. Has to be 
+	 * called before connecting.
+	 *
+	 * The receiver has to be destructed in the owner thread. Destructing it 
+	 * in another thread waits for a signal that is delivered to it right now, 
+	 * which deadlocks if the callback waits for the destructing thread.
+	 *
+	 * The receiver only keeps a reference to the executor. The executor has 
+	 * to outlive the receiver and every signal sent to it, use the overload 
+	 * for shared executors otherwise.
+	 *
+	 * @param executor
+	 *              Any object with a method post(std::function<void()>) that 
+	 *              executes the given function in the calling thread, e.g., 
+	 *              an event loop.
+	 */
+	template <typename ExecutorType>
+	void setExecutor(ExecutorType& executor) {
+
+		setAffinity([&executor](ReceiverAffinity::task_type task) { executor.post(task); });
+	}
+
+	/**
+	 * Same as setExecutor(ExecutorType&), but keeps the executor alive for as 
+	 * long as signals might be posted to it.
+	 */
+	template <typename ExecutorType>
+	void setExecutor(boost::shared_ptr<ExecutorType> executor) {
+
+		setAffinity([executor](ReceiverAffinity::task_type task) { executor->post(task); });
+	}
+
+	/**
+	 * Get the affinity created by setExecutor().
+	 */
+	const boost::shared_ptr<ReceiverAffinity>& getAffinity() const {
+
+		return _affinity;
 	}
 
 	callbacks_type& getCallbacks() {
@@ -53,13 +121,146 @@ public:
 		return _callbacks;
 	}
 
+	/**
+	 * Get all callbacks that accept signals of the given type, in the same 
+	 * order as getCallbacks(), i.e., the exclusive callbacks from most to 
+	 * least specific, followed by the transparent callbacks. The result is 
+	 * cached until the next callback gets registered.
+	 *
+	 * The returned reference stays valid for the lifetime of the receiver, 
+	 * also when other signal types are queried. Its content is only updated 
+	 * by the first query after a callback got registered.
+	 */
+	const callbacks_type& getCallbacks(SignalTypeId signalType) {
+
+		Candidates& candidates = _index[signalType];
+
+		if (!candidates.valid) {
+
+			candidates.callbacks.clear();
+
+			for (CallbackBase* callback : _callbacks)
+				if (SignalTypes::isCompatible(signalType, callback->getSignalType()))
+					candidates.callbacks.push_back(callback);
+
+			candidates.valid = true;
+		}
+
+		return candidates.callbacks;
+	}
+
 private:
 
+	/**
+	 * The compatible callbacks for one signal type.
+	 */
+	struct Candidates {
+
+		Candidates() : valid(false) {}
+
+		callbacks_type callbacks;
+		bool           valid;
+	};
+
+	// the candidates of the signal types queried so far, in a node-based map 
+	// such that references to them stay valid
+	typedef std::map<SignalTypeId, Candidates> index_type;
+
+	/**
+	 * Create an affinity to the calling thread that posts via the given 
+	 * function, and bind all callbacks to it.
+	 */
+	void setAffinity(ReceiverAffinity::post_function_type post) {
+
+		_affinity = boost::make_shared<ReceiverAffinity>(post);
+
+		for (CallbackBase* callback : _callbacks)
+			callback->setAffinity(_affinity);
+	}
+
+	/**
+	 * Invalidate the cached compatible callbacks of all signal types.
+	 */
+	void invalidateIndex() {
+
+		for (index_type::value_type& entry : _index)
+			entry.second.valid = false;
+	}
+
+	/**
+	 * Insert a callback at its sorted position.
+	 */
+	void insert(CallbackBase* callback) {
+
+		// make sure that transparent callbacks or callbacks of the same 
+		// specificity are called in the reverse order in which they have been 
+		// added
+		callback->setPrecendence(_callbacks.size());
+		callback->setAffinity(_affinity);
+
+		// new signal types might have changed the keys, sort everything
+		if (_numSignalTypes != SignalTypes::size()) {
+
+			_callbacks.push_back(callback);
+			sort();
+			return;
+		}
+
+		std::uint64_t key = CallbackComparator::key(*callback);
+		size_t position = std::upper_bound(_keys.begin(), _keys.end(), key) - _keys.begin();
+
+		_callbacks.insert(_callbacks.begin() + position, callback);
+		_keys.insert(_keys.begin() + position, key);
+
+		invalidateIndex();
+	}
+
+	/**
+	 * Recompute the keys of all callbacks and sort them.
+	 */
+	void sort() {
+
+		_numSignalTypes = SignalTypes::size();
+
+		std::vector<std::pair<std::uint64_t, CallbackBase*> > sorted;
+		sorted.reserve(_callbacks.size());
+
+		for (CallbackBase* callback : _callbacks)
+			sorted.push_back(std::make_pair(CallbackComparator::key(*callback), callback));
+
+		std::sort(sorted.begin(), sorted.end());
+
+		_keys.resize(sorted.size());
+		for (size_t i = 0; i < sorted.size(); i++) {
+
+			_keys[i]      = sorted[i].first;
+			_callbacks[i] = sorted[i].second;
+		}
+
+		invalidateIndex();
+	}
+
+	// all callbacks, sorted by CallbackComparator
 	callbacks_type _callbacks;
+
+	// the sort keys of the callbacks
+	std::vector<std::uint64_t> _keys;
+
+	// the compatible callbacks per signal type, built on demand for the types 
+	// this receiver gets asked for
+	index_type _index;
+
+	// callbacks owned by this receiver
 	callbacks_type _own;
+
+	// the thread the callbacks have to be called in, if any
+	boost::shared_ptr<ReceiverAffinity> _affinity;
+
+	// the number of registered signal types at the time the keys were 
+	// computed
+	unsigned int _numSignalTypes;
 };
 
 } // namespace signals
 
 #endif // SIGNALS_RECEIVER_H__
-
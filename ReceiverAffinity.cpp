@@ -0,0 +1,142 @@
+#include <boost/shared_ptr.hpp>
+
+#include "ReceiverAffinity.h"
+
+namespace signals {
+
+ReceiverAffinity::ReceiverAffinity(post_function_type post) :
+	_post(post),
+	_owner(boost::this_thread::get_id()),
+	_head(&_stub),
+	_tail(&_stub),
+	_drainPosted(false),
+	_closed(false) {
+
+	_stub.next.store(0, boost::memory_order_relaxed);
+}
+
+ReceiverAffinity::~ReceiverAffinity() {
+
+	// drop tasks that have not been executed
+	while (Node* node = pop())
+		delete node;
+}
+
+void
+ReceiverAffinity::post(task_type task) {
+
+	if (_closed.load(boost::memory_order_acquire))
+		return;
+
+	Node* node = new Node();
+	node->task = std::move(task);
+
+	push(node);
+
+	if (_drainPosted.exchange(true, boost::memory_order_acq_rel))
+		return;
+
+	// the drain task keeps us alive until it ran
+	boost::shared_ptr<ReceiverAffinity> self = shared_from_this();
+
+	_post([self]{ self->drain(); });
+}
+
+std::size_t
+ReceiverAffinity::drain() {
+
+	// tasks pushed from now on will post another drain
+	_drainPosted.store(false, boost::memory_order_seq_cst);
+
+	std::size_t executed = 0;
+
+	while (Node* node = pop()) {
+
+		// a task might have destructed the receiver, in which case the 
+		// receiver closed us from within the task and we must not lock again
+		if (!_closed.load(boost::memory_order_acquire)) {
+
+			// close() from other threads waits for the task to finish
+			boost::mutex::scoped_lock lock(_taskMutex);
+
+			if (!_closed.load(boost::memory_order_acquire)) {
+
+				node->task();
+				executed++;
+			}
+		}
+
+		delete node;
+	}
+
+	return executed;
+}
+
+void
+ReceiverAffinity::close() {
+
+	_closed.store(true, boost::memory_order_release);
+
+	// tasks that are pushed concurrently get dropped by the pending drain
+	if (isOwnerThread()) {
+
+		drain();
+		return;
+	}
+
+	// wait for a task that is executed by the owner thread right now, later 
+	// tasks see that we are closed
+	boost::mutex::scoped_lock lock(_taskMutex);
+}
+
+void
+ReceiverAffinity::push(Node* node) {
+
+	node->next.store(0, boost::memory_order_relaxed);
+
+	Node* previous = _head.exchange(node, boost::memory_order_acq_rel);
+	previous->next.store(node, boost::memory_order_release);
+}
+
+ReceiverAffinity::Node*
+ReceiverAffinity::pop() {
+
+	Node* tail = _tail;
+	Node* next = tail->next.load(boost::memory_order_acquire);
+
+	if (tail == &_stub) {
+
+		if (!next)
+			return 0;
+
+		_tail = next;
+		tail  = next;
+		next  = next->next.load(boost::memory_order_acquire);
+	}
+
+	if (next) {
+
+		_tail = next;
+		return tail;
+	}
+
+	// a producer is between exchanging the head and linking its node, its 
+	// drain will get the node
+	if (tail != _head.load(boost::memory_order_acquire))
+		return 0;
+
+	// tail is the last node, put the stub behind it to be able to take it
+	push(&_stub);
+
+	next = tail->next.load(boost::memory_order_acquire);
+
+	if (next) {
+
+		_tail = next;
+		return tail;
+	}
+
+	return 0;
+}
+
+} // namespace signals
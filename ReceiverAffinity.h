@@ -0,0 +1,103 @@
+#ifndef SIGNALS_RECEIVER_AFFINITY_H__
+#define SIGNALS_RECEIVER_AFFINITY_H__
+
+#include <functional>
+#include <boost/atomic.hpp>
+#include <boost/enable_shared_from_this.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/thread.hpp>
+
+namespace signals {
+
+/**
+ * Binds the callbacks of a receiver to the thread of an executor (like the 
+ * event loop of a UI or IO thread). Signals sent from the owner thread are 
+ * delivered directly. Signals sent from other threads are put into a 
+ * lock-free multi-producer, single-consumer queue, which is drained in the 
+ * owner thread by a task posted to the executor. Only one drain task is 
+ * pending at a time, no matter how many signals are queued. The drain task 
+ * keeps the affinity alive, but not the receiver: the receiver closes its 
+ * affinity when it gets destructed, which drops all pending tasks.
+ *
+ * Created via Receiver::setExecutor().
+ */
+class ReceiverAffinity :
+		public boost::enable_shared_from_this<ReceiverAffinity>,
+		public boost::noncopyable {
+
+public:
+
+	typedef std::function<void()>          task_type;
+	typedef std::function<void(task_type)> post_function_type;
+
+	/**
+	 * Create an affinity to the calling thread, which has to be the thread 
+	 * that executes the tasks posted via post.
+	 */
+	ReceiverAffinity(post_function_type post);
+
+	~ReceiverAffinity();
+
+	/**
+	 * Returns true, if called from the owner thread.
+	 */
+	bool isOwnerThread() const {
+
+		return boost::this_thread::get_id() == _owner;
+	}
+
+	/**
+	 * Queue a task for execution in the owner thread.
+	 */
+	void post(task_type task);
+
+	/**
+	 * Execute all queued tasks. Called in the owner thread by the task posted 
+	 * to the executor, can also be called directly by the owner thread.
+	 *
+	 * @return The number of executed tasks.
+	 */
+	std::size_t drain();
+
+	/**
+	 * Drop all queued tasks and ignore tasks posted from now on. Called by 
+	 * the receiver before its callbacks are destructed. If called from 
+	 * another thread than the owner thread, waits for a task that is 
+	 * executed right now to finish.
+	 */
+	void close();
+
+private:
+
+	struct Node {
+
+		boost::atomic<Node*> next;
+		task_type            task;
+	};
+
+	void push(Node* node);
+
+	Node* pop();
+
+	post_function_type _post;
+
+	boost::thread::id _owner;
+
+	// producers push at the head, the consumer pops at the tail
+	boost::atomic<Node*> _head;
+	Node*                _tail;
+	Node                 _stub;
+
+	// a drain task is posted to the executor and did not start yet
+	boost::atomic<bool> _drainPosted;
+
+	// the receiver is gone, tasks must not be executed anymore
+	boost::atomic<bool> _closed;
+
+	// held by the owner thread while it executes a task
+	boost::mutex _taskMutex;
+};
+
+} // namespace signals
+
+#endif // SIGNALS_RECEIVER_AFFINITY_H__
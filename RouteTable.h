@@ -0,0 +1,78 @@
+#ifndef SIGNALS_ROUTE_TABLE_H__
+#define SIGNALS_ROUTE_TABLE_H__
+
+#include <algorithm>
+#include <vector>
+
+namespace signals {
+
+/**
+ * One side of the routes through a pass-through tunnel: the real slots that 
+ * enter the tunnel at its PassThroughCallback, or the receivers it leads to at 
+ * its PassThroughSlot. Kept as a sorted vector, such that lookups are 
+ * logarithmic and iterating does not chase tree nodes.
+ */
+template <typename T>
+class RouteTable {
+
+	typedef std::vector<T*> entries_type;
+
+public:
+
+	typedef typename entries_type::iterator       iterator;
+	typedef typename entries_type::const_iterator const_iterator;
+
+	/**
+	 * Add an entry.
+	 *
+	 * @return false, if the entry was present already.
+	 */
+	bool insert(T* entry) {
+
+		iterator i = std::lower_bound(_entries.begin(), _entries.end(), entry);
+
+		if (i != _entries.end() && *i == entry)
+			return false;
+
+		_entries.insert(i, entry);
+
+		return true;
+	}
+
+	/**
+	 * Remove an entry.
+	 *
+	 * @return 1, if the entry was present, 0 otherwise.
+	 */
+	size_t erase(T* entry) {
+
+		iterator i = std::lower_bound(_entries.begin(), _entries.end(), entry);
+
+		if (i == _entries.end() || *i != entry)
+			return 0;
+
+		_entries.erase(i);
+
+		return 1;
+	}
+
+	bool contains(T* entry) const {
+
+		return std::binary_search(_entries.begin(), _entries.end(), entry);
+	}
+
+	size_t size() const { return _entries.size(); }
+
+	iterator begin() { return _entries.begin(); }
+	iterator end() { return _entries.end(); }
+	const_iterator begin() const { return _entries.begin(); }
+	const_iterator end() const { return _entries.end(); }
+
+private:
+
+	entries_type _entries;
+};
+
+} // namespace signals
+
+#endif // SIGNALS_ROUTE_TABLE_H__
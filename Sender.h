@@ -1,7 +1,7 @@
 #ifndef SIGNALS_SENDER_H__
 #define SIGNALS_SENDER_H__
 
-#include <vector>
+#include <list>
 #include "SlotComparator.h"
 #include "Logging.h"
 
@@ -26,9 +26,17 @@ public:
 		_slots.sort(SlotComparator());
 	}
 
+	/**
+	 * Get all slots registered with this sender.
+	 */
+	const slots_type& getSlots() const {
+
+		return _slots;
+	}
+
 	void connect(Receiver& receiver) {
 
-		LOG_ALL(signalslog) << "sender trying to connect to receiver" << std::endl;
+		SIGNALS_LOG_CONNECTIONS(signalslog) << "sender trying to connect to receiver" << std::endl;
 
 		// for every slot we provide
 		for (slots_type::iterator slot = _slots.begin();
@@ -40,7 +48,7 @@ public:
 
 	void disconnect(Receiver& receiver) {
 
-		LOG_ALL(signalslog) << "sender disconnecting from receiver" << std::endl;
+		SIGNALS_LOG_CONNECTIONS(signalslog) << "sender disconnecting from receiver" << std::endl;
 
 		// for every slot we provide
 		for (slots_type::iterator slot = _slots.begin();
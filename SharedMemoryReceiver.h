@@ -0,0 +1,98 @@
+#ifndef SIGNALS_SHARED_MEMORY_RECEIVER_H__
+#define SIGNALS_SHARED_MEMORY_RECEIVER_H__
+
+#include <string>
+#include <vector>
+
+#include "Sender.h"
+#include "SharedMemoryRing.h"
+#include "Slot.h"
+
+namespace signals {
+
+/**
+ * Receiving end of a shared memory transport. Signals sent by 
+ * SharedMemorySlots of the same name are re-emitted by this sender whenever 
+ * poll() is called. Local receivers connect to it like to any other sender.
+ *
+ * Requires SignalType to be a PayloadSignal.
+ */
+template <typename SignalType>
+class SharedMemoryReceiver : public Sender {
+
+	typedef typename SignalType::payload_type payload_type;
+
+public:
+
+	/**
+	 * Create a shared memory receiver.
+	 *
+	 * @param name
+	 *              The name of the transport, e.g., "/myapp.moved".
+	 * @param capacity
+	 *              The number of signals that can be in transit.
+	 * @param batchSize
+	 *              The maximal number of signals to re-emit as one batch.
+	 */
+	SharedMemoryReceiver(const std::string& name, std::size_t capacity = 4096, std::size_t batchSize = 64) :
+		_ring(name, sizeof(payload_type), capacity),
+		_batch(batchSize) {
+
+		registerSlot(_slot);
+	}
+
+	/**
+	 * Re-emit the signals that arrived since the last call. Signals are sent 
+	 * in batches, see Slot::sendBatch().
+	 *
+	 * @param maxSignals
+	 *              Stop after this many signals.
+	 * @return The number of signals re-emitted.
+	 */
+	std::size_t poll(std::size_t maxSignals = std::size_t(-1)) {
+
+		std::size_t received = 0;
+
+		while (received < maxSignals) {
+
+			std::size_t size = 0;
+
+			while (size < _batch.size() && received + size < maxSignals && _ring.tryPop(&_batch[size].payload))
+				size++;
+
+			if (size == 0)
+				break;
+
+			_slot.sendBatch(_batch.data(), _batch.data() + size);
+			received += size;
+
+			if (size < _batch.size())
+				break;
+		}
+
+		return received;
+	}
+
+	/**
+	 * Returns false, if the transport could not be established, see 
+	 * SharedMemoryRing::isValid().
+	 */
+	bool isValid() const {
+
+		return _ring.isValid();
+	}
+
+private:
+
+	SharedMemoryRing _ring;
+
+	// the local slot to re-emit signals
+	Slot<SignalType> _slot;
+
+	// signals that are re-emitted together
+	std::vector<SignalType> _batch;
+};
+
+} // namespace signals
+
+#endif // SIGNALS_SHARED_MEMORY_RECEIVER_H__
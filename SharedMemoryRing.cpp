@@ -0,0 +1,273 @@
+#include <chrono>
+#include <cstring>
+#include <boost/atomic.hpp>
+#include <boost/thread.hpp>
+
+#include "Logging.h"
+#include "SharedMemoryRing.h"
+
+#if BOOST_ATOMIC_INT64_LOCK_FREE != 2
+#error "SharedMemoryRing needs lock-free 64 bit atomics"
+#endif
+
+namespace signals {
+
+namespace {
+
+	enum State {
+
+		Uninitialized = 0,
+		Initializing  = 1,
+		Ready         = 2
+	};
+
+	const std::size_t CacheLineSize = 64;
+
+	// how long to wait for another process to create and initialize a ring
+	const std::chrono::milliseconds InitializationTimeout(1000);
+
+	/**
+	 * Yield until done() returns true or the initialization timeout expired.
+	 *
+	 * @return false, if the timeout expired.
+	 */
+	template <typename Predicate>
+	bool waitFor(Predicate done) {
+
+		std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + InitializationTimeout;
+
+		while (!done()) {
+
+			if (std::chrono::steady_clock::now() > deadline)
+				return false;
+
+			boost::this_thread::yield();
+		}
+
+		return true;
+	}
+
+	std::size_t roundUp(std::size_t value, std::size_t multiple) {
+
+		return (value + multiple - 1)/multiple*multiple;
+	}
+
+	std::size_t nextPowerOfTwo(std::size_t value) {
+
+		std::size_t power = 1;
+		while (power < value)
+			power *= 2;
+
+		return power;
+	}
+}
+
+/**
+ * Beginning of the shared memory. Producers and consumer positions are kept in 
+ * their own cache lines.
+ */
+struct SharedMemoryRing::Header {
+
+	boost::atomic<std::uint32_t> state;
+	std::uint64_t                recordSize;
+	std::uint64_t                capacity;
+
+	alignas(CacheLineSize) boost::atomic<std::uint64_t> pushPosition;
+	alignas(CacheLineSize) boost::atomic<std::uint64_t> popPosition;
+};
+
+/**
+ * A cell of the ring, followed by the record. The cell for position p is 
+ * ready to be written if sequence == p, and ready to be read if 
+ * sequence == p + 1.
+ */
+struct SharedMemoryRing::Cell {
+
+	boost::atomic<std::uint64_t> sequence;
+
+	char* record() { return reinterpret_cast<char*>(this) + sizeof(Cell); }
+};
+
+SharedMemoryRing::SharedMemoryRing(const std::string& name, std::size_t recordSize, std::size_t capacity) :
+	_header(0),
+	_cells(0),
+	_recordSize(recordSize),
+	_capacity(nextPowerOfTwo(capacity)),
+	_cellSize(roundUp(sizeof(Cell) + recordSize, alignof(Cell))) {
+
+	std::size_t headerSize = roundUp(sizeof(Header), CacheLineSize);
+	std::size_t size       = headerSize + _capacity*_cellSize;
+
+	// Only the process that creates the shared memory object sets its size. 
+	// Processes that open it concurrently with other capacities would 
+	// otherwise resize each other's mappings.
+	bool created = true;
+
+	try {
+
+		_memory = boost::interprocess::shared_memory_object(boost::interprocess::create_only, name.c_str(), boost::interprocess::read_write);
+
+	} catch (const boost::interprocess::interprocess_exception& e) {
+
+		if (e.get_error_code() != boost::interprocess::already_exists_error)
+			throw;
+
+		created = false;
+	}
+
+	if (created) {
+
+		_memory.truncate(size);
+
+	} else {
+
+		_memory = boost::interprocess::shared_memory_object(boost::interprocess::open_only, name.c_str(), boost::interprocess::read_write);
+
+		// the creator might not have set the size yet
+		bool sized = waitFor([this]{
+
+			boost::interprocess::offset_t existingSize = 0;
+			_memory.get_size(existingSize);
+
+			return existingSize != 0;
+		});
+
+		if (!sized) {
+
+			LOG_ERROR(signalslog) << "shared memory ring " << name << " was not created in time" << std::endl;
+			return;
+		}
+	}
+
+	// the mapping is zero-filled, i.e., Uninitialized, if we just created it
+	_region = boost::interprocess::mapped_region(_memory, boost::interprocess::read_write);
+
+	if (_region.get_size() != size) {
+
+		LOG_ERROR(signalslog)
+				<< "shared memory ring " << name << " has size " << _region.get_size()
+				<< ", but " << size << " bytes are needed" << std::endl;
+
+		return;
+	}
+
+	Header* header = static_cast<Header*>(_region.get_address());
+
+	std::uint32_t state = Uninitialized;
+
+	if (header->state.compare_exchange_strong(state, Initializing, boost::memory_order_acquire)) {
+
+		header->recordSize = _recordSize;
+		header->capacity   = _capacity;
+		header->pushPosition.store(0, boost::memory_order_relaxed);
+		header->popPosition.store(0, boost::memory_order_relaxed);
+
+		_cells = static_cast<char*>(_region.get_address()) + headerSize;
+		for (std::uint64_t i = 0; i < _capacity; i++)
+			cell(i).sequence.store(i, boost::memory_order_relaxed);
+
+		header->state.store(Ready, boost::memory_order_release);
+
+	} else {
+
+		// the creator might have died while initializing
+		bool ready = waitFor([header]{ return header->state.load(boost::memory_order_acquire) == Ready; });
+
+		if (!ready) {
+
+			LOG_ERROR(signalslog) << "shared memory ring " << name << " was not initialized in time" << std::endl;
+			return;
+		}
+	}
+
+	if (header->recordSize != _recordSize || header->capacity != _capacity) {
+
+		LOG_ERROR(signalslog)
+				<< "shared memory ring " << name << " has records of size "
+				<< header->recordSize << " and capacity " << header->capacity
+				<< ", but " << _recordSize << " and " << _capacity
+				<< " were requested" << std::endl;
+
+		_cells = 0;
+		return;
+	}
+
+	_header = header;
+	_cells  = static_cast<char*>(_region.get_address()) + headerSize;
+}
+
+bool
+SharedMemoryRing::tryPush(const void* record) {
+
+	if (!_header)
+		return false;
+
+	std::uint64_t position = _header->pushPosition.load(boost::memory_order_relaxed);
+
+	while (true) {
+
+		Cell& c = cell(position);
+
+		std::int64_t difference =
+				static_cast<std::int64_t>(c.sequence.load(boost::memory_order_acquire)) -
+				static_cast<std::int64_t>(position);
+
+		// the cell is free, try to claim it
+		if (difference == 0) {
+
+			if (_header->pushPosition.compare_exchange_weak(position, position + 1, boost::memory_order_relaxed)) {
+
+				std::memcpy(c.record(), record, _recordSize);
+				c.sequence.store(position + 1, boost::memory_order_release);
+
+				return true;
+			}
+
+		// the cell has not been read yet, the ring is full
+		} else if (difference < 0) {
+
+			return false;
+
+		// another producer claimed the cell
+		} else {
+
+			position = _header->pushPosition.load(boost::memory_order_relaxed);
+		}
+	}
+}
+
+bool
+SharedMemoryRing::tryPop(void* record) {
+
+	if (!_header)
+		return false;
+
+	std::uint64_t position = _header->popPosition.load(boost::memory_order_relaxed);
+
+	Cell& c = cell(position);
+
+	if (c.sequence.load(boost::memory_order_acquire) != position + 1)
+		return false;
+
+	std::memcpy(record, c.record(), _recordSize);
+
+	// hand the cell to the producers for the next round
+	c.sequence.store(position + _capacity, boost::memory_order_release);
+	_header->popPosition.store(position + 1, boost::memory_order_relaxed);
+
+	return true;
+}
+
+void
+SharedMemoryRing::remove(const std::string& name) {
+
+	boost::interprocess::shared_memory_object::remove(name.c_str());
+}
+
+SharedMemoryRing::Cell&
+SharedMemoryRing::cell(std::uint64_t position) {
+
+	return *reinterpret_cast<Cell*>(_cells + (position & (_capacity - 1))*_cellSize);
+}
+
+} // namespace signals
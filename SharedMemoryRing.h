@@ -0,0 +1,94 @@
+#ifndef SIGNALS_SHARED_MEMORY_RING_H__
+#define SIGNALS_SHARED_MEMORY_RING_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/interprocess/shared_memory_object.hpp>
+#include <boost/noncopyable.hpp>
+
+namespace signals {
+
+/**
+ * Bounded queue of fixed-size records in POSIX shared memory, to pass signals 
+ * between processes on the same host. Any number of producers (in any number 
+ * of processes) can push concurrently, records have to be popped by a single 
+ * consumer. Pushing and popping never block and never take a lock; every cell 
+ * of the ring carries a sequence number that tells whether it is ready to be 
+ * written or read.
+ *
+ * The first process to open a ring of a given name creates and initializes 
+ * it, all others have to agree on record size and capacity. Processes that 
+ * open an existing ring wait at most a second for its creator.
+ */
+class SharedMemoryRing : public boost::noncopyable {
+
+public:
+
+	/**
+	 * Open the ring of the given name, create it if it does not exist.
+	 *
+	 * @param name
+	 *              The name of the shared memory object, e.g., "/myapp.moved".
+	 * @param recordSize
+	 *              The size of one record in bytes.
+	 * @param capacity
+	 *              The maximal number of records in the ring, rounded up to 
+	 *              the next power of two.
+	 */
+	SharedMemoryRing(const std::string& name, std::size_t recordSize, std::size_t capacity);
+
+	/**
+	 * Returns false, if the ring was created by another process with a 
+	 * different record size or capacity, or if its creator did not finish 
+	 * initializing it in time. Pushing and popping always fail on invalid 
+	 * rings.
+	 */
+	bool isValid() const { return _header != 0; }
+
+	/**
+	 * Copy a record into the ring.
+	 *
+	 * @return false, if the ring is full.
+	 */
+	bool tryPush(const void* record);
+
+	/**
+	 * Copy the oldest record out of the ring. Must only be called by one 
+	 * consumer at a time.
+	 *
+	 * @return false, if the ring is empty.
+	 */
+	bool tryPop(void* record);
+
+	std::size_t recordSize() const { return _recordSize; }
+
+	std::size_t capacity() const { return _capacity; }
+
+	/**
+	 * Remove the shared memory object of the given name. Processes that have 
+	 * the ring opened can continue to use it.
+	 */
+	static void remove(const std::string& name);
+
+private:
+
+	struct Header;
+	struct Cell;
+
+	Cell& cell(std::uint64_t position);
+
+	boost::interprocess::shared_memory_object _memory;
+	boost::interprocess::mapped_region        _region;
+
+	Header*     _header;
+	char*       _cells;
+	std::size_t _recordSize;
+	std::size_t _capacity;
+	std::size_t _cellSize;
+};
+
+} // namespace signals
+
+#endif // SIGNALS_SHARED_MEMORY_RING_H__
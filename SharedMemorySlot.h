@@ -0,0 +1,81 @@
+#ifndef SIGNALS_SHARED_MEMORY_SLOT_H__
+#define SIGNALS_SHARED_MEMORY_SLOT_H__
+
+#include <string>
+#include <boost/thread.hpp>
+
+#include "SharedMemoryRing.h"
+
+namespace signals {
+
+/**
+ * Sending end of a shared memory transport. Sends signals like a Slot, but to 
+ * a SharedMemoryReceiver of the same name in another process (or the same 
+ * one). Any number of SharedMemorySlots can send to the same name.
+ *
+ * Requires SignalType to be a PayloadSignal. Only the payload is transported.
+ */
+template <typename SignalType>
+class SharedMemorySlot {
+
+	typedef typename SignalType::payload_type payload_type;
+
+public:
+
+	/**
+	 * Create a shared memory slot.
+	 *
+	 * @param name
+	 *              The name of the transport, the same as the one of the 
+	 *              SharedMemoryReceiver.
+	 * @param capacity
+	 *              The number of signals that can be in transit.
+	 */
+	SharedMemorySlot(const std::string& name, std::size_t capacity = 4096) :
+		_ring(name, sizeof(payload_type), capacity) {}
+
+	/**
+	 * Send a signal. Waits while the transport is full.
+	 */
+	void operator()(const SignalType& signal) {
+
+		while (!trySend(signal))
+			boost::this_thread::yield();
+	}
+
+	/**
+	 * Send a batch of signals. Waits while the transport is full.
+	 */
+	void sendBatch(const SignalType* first, const SignalType* last) {
+
+		for (const SignalType* signal = first; signal != last; signal++)
+			(*this)(*signal);
+	}
+
+	/**
+	 * Send a signal, unless the transport is full.
+	 *
+	 * @return false, if the transport is full or not valid.
+	 */
+	bool trySend(const SignalType& signal) {
+
+		return _ring.tryPush(&signal.payload);
+	}
+
+	/**
+	 * Returns false, if the transport could not be established, see 
+	 * SharedMemoryRing::isValid().
+	 */
+	bool isValid() const {
+
+		return _ring.isValid();
+	}
+
+private:
+
+	SharedMemoryRing _ring;
+};
+
+} // namespace signals
+
+#endif // SIGNALS_SHARED_MEMORY_SLOT_H__
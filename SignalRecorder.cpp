@@ -0,0 +1,102 @@
+#include <chrono>
+#include <cstring>
+
+#include "Logging.h"
+#include "SignalRecorder.h"
+
+namespace signals {
+
+namespace {
+
+	// records are buffered in chunks of this size before they are written
+	const std::size_t BufferSize = 1 << 20;
+
+	/**
+	 * Write size bytes of data to file.
+	 *
+	 * @return false, if writing failed.
+	 */
+	bool writeBytes(std::FILE* file, const void* data, std::size_t size) {
+
+		return size == 0 || std::fwrite(data, size, 1, file) == 1;
+	}
+}
+
+SignalRecorder::SignalRecorder(const std::string& filename) :
+	_file(std::fopen(filename.c_str(), "wb")) {
+
+	if (!_file) {
+
+		LOG_ERROR(signalslog) << "could not open " << filename << " for recording signals" << std::endl;
+		return;
+	}
+
+	std::setvbuf(_file, 0, _IOFBF, BufferSize);
+
+	recording::FileHeader header;
+	std::memcpy(header.magic, recording::Magic, sizeof(header.magic));
+	header.version  = recording::Version;
+	header.reserved = 0;
+
+	if (!writeBytes(_file, &header, sizeof(header)))
+		fail();
+}
+
+SignalRecorder::~SignalRecorder() {
+
+	for (auto& recording : _recordings) {
+
+		recording.first->disconnect(*recording.second);
+		delete recording.first;
+	}
+
+	// closing writes the remaining buffered records
+	if (_file && std::fclose(_file) != 0)
+		LOG_ERROR(signalslog) << "could not write recorded signals" << std::endl;
+}
+
+void
+SignalRecorder::flush() {
+
+	boost::mutex::scoped_lock lock(_mutex);
+
+	if (_file && std::fflush(_file) != 0)
+		fail();
+}
+
+void
+SignalRecorder::write(std::uint32_t slotId, std::uint32_t signalType, const void* payload, std::size_t size) {
+
+	static const char padding[recording::RecordAlignment] = {};
+
+	// take the timestamp under the lock, such that records of concurrent 
+	// writers are ordered by time in the file
+	boost::mutex::scoped_lock lock(_mutex);
+
+	if (!_file)
+		return;
+
+	recording::RecordHeader header;
+	header.timestamp  = std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count();
+	header.slotId     = slotId;
+	header.signalType = signalType;
+	header.size       = size;
+	header.reserved   = 0;
+
+	if (!writeBytes(_file, &header, sizeof(header)) ||
+	    !writeBytes(_file, payload, size) ||
+	    !writeBytes(_file, padding, recording::padded(size) - size))
+		fail();
+}
+
+void
+SignalRecorder::fail() {
+
+	LOG_ERROR(signalslog) << "could not write recorded signals, recording stopped" << std::endl;
+
+	std::fclose(_file);
+	_file = 0;
+}
+
+} // namespace signals
@@ -0,0 +1,100 @@
+#ifndef SIGNALS_SIGNAL_RECORDER_H__
+#define SIGNALS_SIGNAL_RECORDER_H__
+
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <boost/noncopyable.hpp>
+#include <boost/thread.hpp>
+
+#include "Callback.h"
+#include "SignalRecording.h"
+#include "SignalTraits.h"
+
+namespace signals {
+
+/**
+ * Records the signals sent by selected slots to an append-only binary file, 
+ * to be replayed later by SignalReplay. Each record holds a timestamp, the id 
+ * of the slot, the type of the signal, and the payload of the signal (for 
+ * PayloadSignals).
+ *
+ * Usage:
+ *
+ *   SignalRecorder recorder("moves.rec");
+ *   recorder.record(sender.moved, 1);
+ */
+class SignalRecorder : public boost::noncopyable {
+
+public:
+
+	/**
+	 * Create a recorder that writes to the given file. An existing file will 
+	 * be replaced.
+	 */
+	SignalRecorder(const std::string& filename);
+
+	/**
+	 * Disconnects from all recorded slots and closes the file.
+	 */
+	~SignalRecorder();
+
+	/**
+	 * Record all signals sent by the given slot under the given id. The 
+	 * recorder has to be destructed before the slot.
+	 */
+	template <typename SlotType>
+	void record(SlotType& slot, std::uint32_t slotId) {
+
+		typedef typename SlotType::signal_type SignalType;
+
+		Callback<SignalType>* callback = new Callback<SignalType>(
+				[this, slotId](SignalType& signal) {
+
+					write(
+							slotId,
+							recording::typeHash<SignalType>(),
+							recording::Payload<SignalType>::data(signal),
+							recording::Payload<SignalType>::Size);
+				});
+
+		_recordings.push_back(Recording(callback, &slot));
+
+		callback->connect(slot);
+	}
+
+	/**
+	 * Returns false, if the file could not be opened for writing, or if 
+	 * writing to it failed. Recording stops on the first failed write.
+	 */
+	bool isValid() const { return _file != 0; }
+
+	/**
+	 * Write buffered records to the file.
+	 */
+	void flush();
+
+private:
+
+	typedef std::pair<CallbackBase*, SlotBase*> Recording;
+
+	void write(std::uint32_t slotId, std::uint32_t signalType, const void* payload, std::size_t size);
+
+	/**
+	 * Log a failed write and close the file. Requires _mutex to be held, 
+	 * unless called from the constructor.
+	 */
+	void fail();
+
+	std::FILE* _file;
+
+	// the callbacks connected to the recorded slots
+	std::vector<Recording> _recordings;
+
+	// serializes writes of slots that send from several threads
+	boost::mutex _mutex;
+};
+
+} // namespace signals
+
+#endif // SIGNALS_SIGNAL_RECORDER_H__
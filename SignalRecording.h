@@ -0,0 +1,108 @@
+#ifndef SIGNALS_SIGNAL_RECORDING_H__
+#define SIGNALS_SIGNAL_RECORDING_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <typeinfo>
+
+namespace signals {
+
+/**
+ * Binary format of signal recordings, see SignalRecorder and SignalReplay.
+ *
+ * A recording starts with a FileHeader, followed by records. Each record is a 
+ * RecordHeader followed by the payload of the signal, padded to a multiple of 
+ * RecordAlignment.
+ */
+namespace recording {
+
+const char          Magic[8]        = { 'S', 'I', 'G', 'R', 'E', 'C', '\0', '\0' };
+const std::uint32_t Version         = 2;
+const std::size_t   RecordAlignment = 8;
+
+struct FileHeader {
+
+	char          magic[8];
+	std::uint32_t version;
+	std::uint32_t reserved;
+};
+
+struct RecordHeader {
+
+	// nanoseconds since an arbitrary point in time, monotonic within a 
+	// recording
+	std::uint64_t timestamp;
+
+	// the id under which the slot was recorded
+	std::uint32_t slotId;
+
+	// the typeHash() of the signal
+	std::uint32_t signalType;
+
+	// the size of the payload in bytes
+	std::uint32_t size;
+
+	std::uint32_t reserved;
+};
+
+inline std::size_t padded(std::size_t size) {
+
+	return (size + RecordAlignment - 1)/RecordAlignment*RecordAlignment;
+}
+
+/**
+ * Identifies the type of recorded signals. Unlike SignalTypeIds, which depend 
+ * on the order in which a process registers signal types, the hash is the 
+ * same in all processes built with the same compiler: it is the FNV-1a hash 
+ * of the mangled name of the type.
+ */
+template <typename SignalType>
+std::uint32_t typeHash() {
+
+	static const std::uint32_t hash = [] {
+
+		std::uint32_t h = 2166136261u;
+
+		for (const char* c = typeid(SignalType).name(); *c; c++)
+			h = (h ^ static_cast<unsigned char>(*c))*16777619u;
+
+		return h;
+	}();
+
+	return hash;
+}
+
+/**
+ * Access to the payload of signals. Only PayloadSignals have a payload, 
+ * records of other signals are empty.
+ */
+template <typename SignalType, typename = void>
+struct Payload {
+
+	static const std::size_t Size = 0;
+
+	static const void* data(const SignalType&) { return 0; }
+
+	static void assign(SignalType&, const void*) {}
+};
+
+template <typename SignalType>
+struct Payload<SignalType, typename std::conditional<true, void, typename SignalType::payload_type>::type> {
+
+	static const std::size_t Size = sizeof(typename SignalType::payload_type);
+
+	static const void* data(const SignalType& signal) { return &signal.payload; }
+
+	static void assign(SignalType& signal, const void* data) {
+
+		std::memcpy(&signal.payload, data, Size);
+	}
+};
+
+} // namespace recording
+
+} // namespace signals
+
+#endif // SIGNALS_SIGNAL_RECORDING_H__
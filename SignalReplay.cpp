@@ -0,0 +1,110 @@
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+#include <boost/interprocess/file_mapping.hpp>
+
+#include "Logging.h"
+#include "SignalReplay.h"
+
+namespace signals {
+
+SignalReplay::SignalReplay(const std::string& filename) :
+	_begin(0),
+	_end(0) {
+
+	// mapping throws for missing and empty files
+	try {
+
+		boost::interprocess::file_mapping file(filename.c_str(), boost::interprocess::read_only);
+		_region.reset(new boost::interprocess::mapped_region(file, boost::interprocess::read_only));
+
+	} catch (const boost::interprocess::interprocess_exception& e) {
+
+		LOG_ERROR(signalslog) << "could not open " << filename << ": " << e.what() << std::endl;
+		return;
+	}
+
+	const char* data = static_cast<const char*>(_region->get_address());
+	std::size_t size = _region->get_size();
+
+	recording::FileHeader header;
+
+	if (size < sizeof(header)) {
+
+		LOG_ERROR(signalslog) << filename << " is not a signal recording" << std::endl;
+		return;
+	}
+
+	std::memcpy(&header, data, sizeof(header));
+
+	if (std::memcmp(header.magic, recording::Magic, sizeof(header.magic)) != 0 || header.version != recording::Version) {
+
+		LOG_ERROR(signalslog) << filename << " is not a signal recording of version " << recording::Version << std::endl;
+		return;
+	}
+
+	_begin = data + sizeof(header);
+	_end   = data + size;
+}
+
+std::size_t
+SignalReplay::run(Speed speed) {
+
+	std::size_t sent = 0;
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	std::uint64_t firstTimestamp = 0;
+	std::uint64_t lastTimestamp  = 0;
+	std::size_t   mismatched     = 0;
+
+	for (const char* record = _begin; record + sizeof(recording::RecordHeader) <= _end;) {
+
+		recording::RecordHeader header;
+		std::memcpy(&header, record, sizeof(header));
+
+		const char* payload = record + sizeof(header);
+
+		// truncated recording, or a corrupt size
+		if (recording::padded(header.size) > static_cast<std::size_t>(_end - payload))
+			break;
+
+		record = payload + recording::padded(header.size);
+
+		if (header.slotId >= _emitters.size() || !_emitters[header.slotId].emit)
+			continue;
+
+		const Emitter& emitter = _emitters[header.slotId];
+
+		if (header.signalType != emitter.signalType || header.size != emitter.size) {
+
+			mismatched++;
+			continue;
+		}
+
+		if (speed == RecordedSpeed) {
+
+			if (sent == 0)
+				firstTimestamp = lastTimestamp = header.timestamp;
+
+			// older recordings might not be ordered by time, never go back
+			lastTimestamp = std::max(lastTimestamp, header.timestamp);
+
+			std::this_thread::sleep_until(
+					start + std::chrono::nanoseconds(lastTimestamp - firstTimestamp));
+		}
+
+		emitter.emit(payload);
+		sent++;
+	}
+
+	if (mismatched > 0) {
+
+		LOG_ERROR(signalslog) << "skipped " << mismatched << " records whose signal type does not match their slot" << std::endl;
+	}
+
+	return sent;
+}
+
+} // namespace signals
@@ -0,0 +1,124 @@
+#ifndef SIGNALS_SIGNAL_REPLAY_H__
+#define SIGNALS_SIGNAL_REPLAY_H__
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/noncopyable.hpp>
+
+#include "Sender.h"
+#include "SignalRecording.h"
+#include "Slot.h"
+
+namespace signals {
+
+/**
+ * Replays a recording of a SignalRecorder. The recording is memory-mapped, 
+ * and the recorded signals are re-emitted by slots of this sender, one slot 
+ * per recorded slot id.
+ *
+ * Usage:
+ *
+ *   SignalReplay replay("moves.rec");
+ *   replay.addSlot<Moved>(1);
+ *   replay.connect(receiver);
+ *   replay.run();
+ */
+class SignalReplay : public Sender, public boost::noncopyable {
+
+public:
+
+	enum Speed {
+
+		// keep the time between signals as recorded
+		RecordedSpeed,
+
+		// send signals as fast as possible
+		MaximumSpeed
+	};
+
+	/**
+	 * Open a recording. See isValid() for whether this succeeded.
+	 */
+	SignalReplay(const std::string& filename);
+
+	/**
+	 * Create the slot that re-emits the signals recorded under the given 
+	 * slot id. Has to be called before connecting receivers.
+	 */
+	template <typename SignalType>
+	Slot<SignalType>& addSlot(std::uint32_t slotId) {
+
+		Slot<SignalType>* slot = new Slot<SignalType>();
+		_slots.emplace_back(slot);
+
+		registerSlot(*slot);
+
+		if (_emitters.size() <= slotId)
+			_emitters.resize(slotId + 1);
+
+		Emitter& emitter = _emitters[slotId];
+
+		emitter.signalType = recording::typeHash<SignalType>();
+		emitter.size       = recording::Payload<SignalType>::Size;
+		emitter.emit       = [slot](const void* payload) {
+
+			SignalType signal;
+			recording::Payload<SignalType>::assign(signal, payload);
+
+			(*slot)(signal);
+		};
+
+		return *slot;
+	}
+
+	/**
+	 * Returns false, if the file could not be opened or is not a recording.
+	 */
+	bool isValid() const { return _begin != 0; }
+
+	/**
+	 * Re-emit all recorded signals. Records of slot ids without a slot are 
+	 * skipped, as are records whose signal type or size does not match the 
+	 * slot. Stops at the first truncated record.
+	 *
+	 * @return The number of signals sent.
+	 */
+	std::size_t run(Speed speed = MaximumSpeed);
+
+private:
+
+	/**
+	 * Emits the payloads of the records of one slot id.
+	 */
+	struct Emitter {
+
+		// the typeHash() and payload size of the slot's signals
+		std::uint32_t signalType;
+		std::size_t   size;
+
+		// sends a signal with the given payload, empty for slot ids without 
+		// a slot
+		std::function<void(const void* payload)> emit;
+	};
+
+	// the mapped file, stays valid without the file mapping
+	std::unique_ptr<boost::interprocess::mapped_region> _region;
+
+	// the records of the mapped file
+	const char* _begin;
+	const char* _end;
+
+	// the slots created via addSlot()
+	std::vector<std::unique_ptr<SlotBase> > _slots;
+
+	// the emitters of the slots, by slot id
+	std::vector<Emitter> _emitters;
+};
+
+} // namespace signals
+
+#endif // SIGNALS_SIGNAL_REPLAY_H__
@@ -1,6 +1,8 @@
 #ifndef SIGNALS_SIGNAL_TRAITS_H__
 #define SIGNALS_SIGNAL_TRAITS_H__
 
+#include "SignalTypes.h"
+
 namespace signals {
 
 template <typename SignalType>
@@ -9,6 +11,34 @@ class SignalTraits {
 public:
 
 	static SignalType Reference;
+
+	/**
+	 * Get the dense type id of SignalType. The type gets registered with
+	 * SignalTypes on the first call.
+	 */
+	static SignalTypeId id() {
+
+		static const SignalTypeId id = SignalTypes::registerType(registrationReference(), &canCast);
+
+		return id;
+	}
+
+private:
+
+	static bool canCast(const Signal* signal) {
+
+		return dynamic_cast<const SignalType*>(signal) != 0;
+	}
+
+	// Reference used for the registration. Function-local, since signal types
+	// might get registered during static initialization, where Reference might
+	// not be constructed yet.
+	static const Signal& registrationReference() {
+
+		static const SignalType reference = SignalType();
+
+		return reference;
+	}
 };
 
 // If you got an error here, that means most likely that you have a signal that
@@ -18,4 +48,3 @@ template <typename SignalType> SignalType SignalTraits<SignalType>::Reference =
 } // namespace signals
 
 #endif // SIGNALS_SIGNAL_TRAITS_H__
-
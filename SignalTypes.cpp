@@ -0,0 +1,74 @@
+#include <stdexcept>
+#include <boost/thread/mutex.hpp>
+
+#include "Signal.h"
+#include "SignalTypes.h"
+
+namespace signals {
+
+SignalTypes::Row* SignalTypes::_chunks[SignalTypes::MaxChunks];
+
+namespace {
+
+	// guards the registration of new signal types (function-local, since
+	// types might get registered during static initialization)
+	boost::mutex& registryMutex() {
+
+		static boost::mutex mutex;
+		return mutex;
+	}
+
+	// the number of registered signal types
+	boost::atomic<unsigned int> numTypes(0);
+}
+
+SignalTypeId
+SignalTypes::registerType(const Signal& reference, cast_test_type canCast) {
+
+	boost::mutex::scoped_lock lock(registryMutex());
+
+	SignalTypeId id = numTypes.load();
+
+	if (id == ChunkSize*MaxChunks)
+		throw std::length_error("too many signal types registered");
+
+	if (id%ChunkSize == 0)
+		_chunks[id/ChunkSize] = new Row[ChunkSize];
+
+	Row& row = _chunks[id/ChunkSize][id%ChunkSize];
+
+	row.reference = &reference;
+	row.canCast   = canCast;
+	row.derivedFrom.resize((id + 63)/64, 0);
+	row.baseOf.resize((id + 63)/64, 0);
+	row.numAncestors.store(1);
+
+	for (SignalTypeId other = 0; other < id; other++) {
+
+		Row& otherRow = _chunks[other/ChunkSize][other%ChunkSize];
+
+		if (otherRow.canCast(&reference)) {
+
+			row.derivedFrom[other/64] |= std::uint64_t(1) << (other%64);
+			row.numAncestors.fetch_add(1);
+		}
+
+		if (canCast(otherRow.reference)) {
+
+			row.baseOf[other/64] |= std::uint64_t(1) << (other%64);
+			otherRow.numAncestors.fetch_add(1);
+		}
+	}
+
+	numTypes.store(id + 1);
+
+	return id;
+}
+
+unsigned int
+SignalTypes::size() {
+
+	return numTypes.load();
+}
+
+} // namespace signals
@@ -0,0 +1,123 @@
+#ifndef SIGNALS_SIGNAL_TYPES_H__
+#define SIGNALS_SIGNAL_TYPES_H__
+
+#include <cstdint>
+#include <vector>
+#include <boost/atomic.hpp>
+
+namespace signals {
+
+// forward declaration
+class Signal;
+
+/**
+ * Dense integer identifier of a signal type. See SignalTraits::id().
+ */
+typedef unsigned int SignalTypeId;
+
+/**
+ * Registry of all signal types in use. Every signal type gets a dense id on
+ * registration, together with its compatibility to all previously registered
+ * types. Compatibility of two signal types is therefore computed only once
+ * (via dynamic_cast) and tested afterwards with a single bit lookup.
+ *
+ * Signal types register themselves on first use of SignalTraits::id().
+ */
+class SignalTypes {
+
+public:
+
+	/**
+	 * Function to test whether a signal can be cast into a certain signal type.
+	 */
+	typedef bool (*cast_test_type)(const Signal*);
+
+	/**
+	 * Register a new signal type.
+	 *
+	 * @param reference
+	 *              A reference signal of the new type. Has to stay valid for
+	 *              the lifetime of the program.
+	 *
+	 * @param canCast
+	 *              A function that tests whether a given signal can be cast
+	 *              into the new type.
+	 *
+	 * @return The id of the new signal type.
+	 */
+	static SignalTypeId registerType(const Signal& reference, cast_test_type canCast);
+
+	/**
+	 * Return true, if signals of type from can be cast into signals of type to,
+	 * i.e., if both types are the same or from is derived from to.
+	 */
+	static bool isCompatible(SignalTypeId from, SignalTypeId to) {
+
+		if (from == to)
+			return true;
+
+		if (from > to)
+			return test(row(from).derivedFrom, to);
+
+		return test(row(to).baseOf, from);
+	}
+
+	/**
+	 * Get the number of registered types that signals of the given type can be 
+	 * cast into (including the type itself). If a type is derived from 
+	 * another one, it has more ancestors. This gives a total order of signal 
+	 * types that is consistent with their specificity. The number might grow 
+	 * when new types get registered, see size().
+	 */
+	static unsigned int numAncestors(SignalTypeId id) {
+
+		return row(id).numAncestors.load(boost::memory_order_relaxed);
+	}
+
+	/**
+	 * Get the number of registered signal types.
+	 */
+	static unsigned int size();
+
+private:
+
+	// compatibility of one signal type to all previously registered types
+	struct Row {
+
+		// the reference signal of this type
+		const Signal* reference;
+
+		// test whether a signal can be cast into this type
+		cast_test_type canCast;
+
+		// bit i is set, if this type can be cast into type i
+		std::vector<std::uint64_t> derivedFrom;
+
+		// bit i is set, if type i can be cast into this type
+		std::vector<std::uint64_t> baseOf;
+
+		// the number of registered types this type can be cast into
+		boost::atomic<unsigned int> numAncestors;
+	};
+
+	static const unsigned int ChunkSize = 256;
+	static const unsigned int MaxChunks = 256;
+
+	static bool test(const std::vector<std::uint64_t>& bits, SignalTypeId i) {
+
+		return (bits[i/64] >> (i%64)) & 1;
+	}
+
+	static const Row& row(SignalTypeId id) {
+
+		return _chunks[id/ChunkSize][id%ChunkSize];
+	}
+
+	// Rows are allocated in chunks that are never moved, such that rows can be
+	// read without synchronization while new types get registered.
+	static Row* _chunks[MaxChunks];
+};
+
+} // namespace signals
+
+#endif // SIGNALS_SIGNAL_TYPES_H__
@@ -1,23 +1,59 @@
 #ifndef SIGNALS_SLOT_H__
 #define SIGNALS_SLOT_H__
 
+#include <type_traits>
+#include <typeinfo>
 #include <utility>
-#include <boost/thread.hpp>
+#include <boost/optional.hpp>
 
 #include "Signal.h"
 #include "SignalTraits.h"
 #include "SlotBase.h"
 #include "Receiver.h"
 #include "CallbackInvoker.h"
+#include "CallbackTracking.h"
+#include "Connection.h"
+#include "DispatchPolicy.h"
+#include "ThreadingPolicy.h"
+#include "SlotInvoker.h"
+#include "ReceiverAffinity.h"
 #include "Logging.h"
 
 namespace signals {
 
-template <typename SignalType, typename CallbackInvokerType = CallbackInvoker<SignalType> >
+/**
+ * Slot for signals of type SignalType. The threading policy determines how the
+ * invokers of connected callbacks are stored: SingleThreaded (default) slots
+ * must not be modified while sending, MultiThreaded slots can be sent from any
+ * number of threads while other threads connect or disconnect callbacks. The
+ * dispatch policy determines whether signals are delivered Synchronous
+ * (default), Queued in a thread pool, or Coalescing until the next flush().
+ *
+ * Invokers are kept in the order of connection, such that the callbacks of a 
+ * receiver get called by their precedence.
+ *
+ * Most slots have few targets. SingleThreaded slots therefore keep the 
+ * invokers of the first InlineTargets callbacks inside the slot, and allocate 
+ * only for more targets.
+ */
+template <
+	typename SignalType,
+	typename CallbackInvokerType = CallbackInvoker<SignalType>,
+	typename ThreadingPolicy = SingleThreaded,
+	typename DispatchPolicy = Synchronous>
 class Slot : public SlotBase {
 
+	static_assert(
+			DispatchPolicy::IsSynchronous || !std::is_same<ThreadingPolicy, SingleThreaded>::value,
+			"slots with asynchronous dispatch need the MultiThreaded threading policy");
+
 public:
 
+	typedef SignalType signal_type;
+
+	Slot() :
+		SlotBase(SignalTraits<SignalType>::id(), typeid(Slot).name()) {}
+
 	virtual ~Slot() {}
 
 	/**
@@ -25,11 +61,7 @@ public:
 	 */
 	void operator()() {
 
-		SignalType signal;
-
-		LOG_ALL(signalslog) << typeName(this) << " sending signal " << typeName(signal) << std::endl;
-
-		send(signal);
+		(*this)(SignalType());
 	}
 
 	/**
@@ -39,9 +71,123 @@ public:
 	 */
 	void operator()(SignalType& signal) {
 
-		LOG_ALL(signalslog) << typeName(this) << " sending signal " << typeName(signal) << std::endl;
+		trace(signal);
+
+		_dispatcher.dispatch(signal, [this](SignalType& signal){ send(signal); });
+	}
+
+	/**
+	 * Send a temporary signal. Slots that keep signals for later delivery 
+	 * (Queued, Coalescing) move it instead of copying it.
+	 *
+	 * Usage:
+	 *
+	 *   meshChanged(MeshChanged(std::move(mesh)));
+	 */
+	void operator()(SignalType&& signal) {
+
+		trace(signal);
+
+		_dispatcher.dispatch(std::move(signal), [this](SignalType& signal){ send(signal); });
+	}
+
+	/**
+	 * Send a signal that must not be modified. Callbacks that take the signal 
+	 * as const reference receive it directly. If other callbacks are 
+	 * connected, they share a single copy of the signal. Slots that keep 
+	 * signals for later delivery (Queued, Coalescing) always copy.
+	 */
+	void operator()(const SignalType& signal) {
+
+		if (!std::is_same<DispatchPolicy, Synchronous>::value) {
+
+			(*this)(SignalType(signal));
+			return;
+		}
+
+		trace(signal);
+
+		sendReadOnly(signal);
+	}
+
+	/**
+	 * Send a signal created by factory(), but only if the slot has targets 
+	 * (see hasTargets()) or a trace hook is set. Use this instead of 
+	 * operator() if creating the signal is expensive.
+	 *
+	 * Usage:
+	 *
+	 *   slot.emitWith([&]{ return ImageChanged(render()); });
+	 *
+	 * @return true, if the signal was created and sent.
+	 */
+	template <typename FactoryType>
+	bool emitWith(FactoryType factory) {
+
+		if (!hasTargets() && !getTraceHook())
+			return false;
+
+		(*this)(SignalType(factory()));
 
-		send(signal);
+		return true;
+	}
+
+	/**
+	 * Construct a signal from the given arguments and send it, but only if the 
+	 * slot has targets or a trace hook is set.
+	 *
+	 * @return true, if the signal was created and sent.
+	 */
+	template <typename... Args>
+	bool emplace(Args&&... args) {
+
+		if (!hasTargets() && !getTraceHook())
+			return false;
+
+		(*this)(SignalType(std::forward<Args>(args)...));
+
+		return true;
+	}
+
+	/**
+	 * Send a batch of signals. Callbacks are invoked for the whole batch 
+	 * before the next callback is considered, such that per-callback work 
+	 * (like locking tracked objects) is done only once per batch. 
+	 * BatchCallbacks receive the whole batch in one call.
+	 *
+	 * @param first Pointer to the first signal of the batch.
+	 * @param last  Pointer past the last signal of the batch.
+	 */
+	void sendBatch(SignalType* first, SignalType* last) {
+
+		if (first == last)
+			return;
+
+		SIGNALS_LOG_SENDS(signalslog) << typeName(this) << " sending batch of " << (last - first) << " signals " << typeName(*first) << std::endl;
+
+		if (trace_hook_type hook = getTraceHook())
+			for (SignalType* signal = first; signal != last; signal++)
+				hook(*this, *signal);
+
+		_dispatcher.dispatchBatch(first, last, [this](SignalType* first, SignalType* last){ send(first, last); });
+	}
+
+	/**
+	 * Deliver pending signals of slots with the Coalescing dispatch policy. 
+	 * Does nothing for other slots.
+	 */
+	void flush() {
+
+		_dispatcher.flush([this](SignalType& signal){ send(signal); });
+	}
+
+	/**
+	 * Wait until all signals sent so far have been delivered. Returns 
+	 * immediately for slots with synchronous dispatch.
+	 */
+	void waitForDelivery() {
+
+		_dispatcher.wait();
 	}
 
 	/**
@@ -59,9 +205,11 @@ public:
 
 		bool exclusiveFound = false;
 
+		const Receiver::callbacks_type& callbacks = receiver.getCallbacks(getSignalType());
+
 		// find all transparent and the first (most specific) exclusive callback
-		for (Receiver::callbacks_type::iterator callback = receiver.getCallbacks().begin();
-			 callback != receiver.getCallbacks().end(); ++callback) {
+		for (Receiver::callbacks_type::const_iterator callback = callbacks.begin();
+			 callback != callbacks.end(); ++callback) {
 
 			// if this is an exclusive callback and we found another
 			// exclusive one already, continue
@@ -82,9 +230,11 @@ public:
 
 	bool disconnect(Receiver& receiver) {
 
-		// for all callbacks of receiver
-		for (Receiver::callbacks_type::iterator callback = receiver.getCallbacks().begin();
-			 callback != receiver.getCallbacks().end(); ++callback) {
+		const Receiver::callbacks_type& callbacks = receiver.getCallbacks(getSignalType());
+
+		// for all compatible callbacks of receiver
+		for (Receiver::callbacks_type::const_iterator callback = callbacks.begin();
+			 callback != callbacks.end(); ++callback) {
 
 			// disconnect
 			(*callback)->disconnect(*this);
@@ -93,6 +243,45 @@ public:
 		return true;
 	}
 
+	/**
+	 * Connect a single callback and get a handle to disconnect it in constant 
+	 * time. Unlike addCallback(), this does not check whether the callback is 
+	 * already connected.
+	 *
+	 * @return A connection handle, which is empty if the callback is not 
+	 *         compatible with this slot.
+	 */
+	Connection connect(CallbackBase& callback) {
+
+		if (!SignalTypes::isCompatible(getSignalType(), callback.getSignalType()))
+			return Connection();
+
+		typename CallbackInvokerType::CallbackBaseType* p = dynamic_cast<typename CallbackInvokerType::CallbackBaseType*>(&callback);
+
+		if (!p)
+			return Connection();
+
+		CallbackTracker tracker;
+		bool            tracked = callback.getTracking(tracker);
+
+		InvokerHandle handle = _invokers.connect(InvokerType(CallbackInvokerType(*p), tracked ? &tracker : 0, callback.getAffinity()));
+
+		SIGNALS_LOG_CONNECTIONS(signalslog) << typeName(callback) << " connected to " << typeName(this) << std::endl;
+
+		return Connection(
+				*this,
+				(std::uint64_t(handle.generation) << 32) |
+				handle.index);
+	}
+
+	/**
+	 * Remove a connection established via connect(CallbackBase&).
+	 */
+	bool removeConnection(std::uint64_t id) {
+
+		return _invokers.disconnect(InvokerHandle(id & 0xffffffff, id >> 32));
+	}
+
 	/**
 	 * Add a callback to this slot.
 	 *
@@ -100,18 +289,19 @@ public:
 	 */
 	bool addCallback(CallbackBase& callback) {
 
-		if (isConnected(callback))
-			return false;
-
 		typename CallbackInvokerType::CallbackBaseType* p = dynamic_cast<typename CallbackInvokerType::CallbackBaseType*>(&callback);
 
 		// not the type of callback we are interested in?
 		if (!p)
 			return false;
 
-		addInvoker(CallbackInvokerType(*p));
+		CallbackTracker tracker;
+		bool            tracked = callback.getTracking(tracker);
+
+		if (!_invokers.add(InvokerType(CallbackInvokerType(*p), tracked ? &tracker : 0, callback.getAffinity())))
+			return false;
 
-		LOG_ALL(signalslog) << typeName(callback) << " connected to " << typeName(this) << std::endl;
+		SIGNALS_LOG_CONNECTIONS(signalslog) << typeName(callback) << " connected to " << typeName(this) << std::endl;
 
 		return true;
 	}
@@ -121,22 +311,69 @@ public:
 	 */
 	bool removeCallback(CallbackBase& callback) {
 
-		if (!isConnected(callback))
-			return false;
-
 		typename CallbackInvokerType::CallbackBaseType* p = dynamic_cast<typename CallbackInvokerType::CallbackBaseType*>(&callback);
 
 		// not the type of callback we are interested in?
 		if (!p)
 			return false;
 
-		removeInvoker(CallbackInvokerType(*p));
+		if (!_invokers.remove(InvokerType(CallbackInvokerType(*p))))
+			return false;
 
-		LOG_ALL(signalslog) << typeName(callback) << " disconnected from " << typeName(this) << std::endl;
+		SIGNALS_LOG_CONNECTIONS(signalslog) << typeName(callback) << " disconnected from " << typeName(this) << std::endl;
 
 		return true;
 	}
 
+	/**
+	 * Remove the invokers of all tracked callbacks whose tracked objects do 
+	 * not exist anymore. Sending removes those invokers as well, this method 
+	 * is meant to clean up at an idle time instead.
+	 *
+	 * @return The number of removed invokers.
+	 */
+	size_t compact() {
+
+		size_t removed = _invokers.removeIf([](const InvokerType& invoker) {
+
+			return invoker.expired();
+		});
+
+#if SIGNALS_INSTRUMENTATION
+		statistics().recordStaleRemoved(removed);
+#endif
+
+		if (removed > 0) {
+
+			SIGNALS_LOG_CONNECTIONS(signalslog) << "removed " << removed << " stale invokers from " << typeName(this) << std::endl;
+		}
+
+		return removed;
+	}
+
+	/**
+	 * Returns true, if the given callback is connected to this slot.
+	 */
+	bool isConnected(CallbackBase& callback) {
+
+		typename CallbackInvokerType::CallbackBaseType* p = dynamic_cast<typename CallbackInvokerType::CallbackBaseType*>(&callback);
+
+		if (!p)
+			return false;
+
+		return _invokers.contains(InvokerType(CallbackInvokerType(*p)));
+	}
+
+	/**
+	 * Check whether any callback is connected. Safe to call while other threads 
+	 * send or connect. Tracked callbacks whose object is gone count until the 
+	 * next send or compact() removes them.
+	 */
+	bool hasTargets() const {
+
+		return _invokers.size() > 0;
+	}
+
 	/**
 	 * Get the number of callbacks that are registered for this slot.
 	 */
@@ -147,71 +384,113 @@ public:
 
 private:
 
-	typedef std::vector<CallbackInvokerType> CallbackInvokersType;
+	typedef SlotInvoker<CallbackInvokerType> InvokerType;
+
+	void trace(const SignalType& signal) {
 
-	bool canSend(const Signal& signal) const {
+		SIGNALS_LOG_SENDS(signalslog) << typeName(this) << " sending signal " << typeName(signal) << std::endl;
 
-		return dynamic_cast<const SignalType*>(&signal);
+		if (trace_hook_type hook = getTraceHook())
+			hook(*this, signal);
 	}
 
-	template <typename CallbackType>
-	bool isConnected(CallbackType& callback) {
+	void send(SignalType& signal) {
 
-		typename CallbackInvokerType::CallbackBaseType* p = dynamic_cast<typename CallbackInvokerType::CallbackBaseType*>(&callback);
+#if SIGNALS_INSTRUMENTATION
+		statistics().recordEmit(numTargets());
+#endif
 
-		// not the type of callback we are interested in?
-		if (!p)
-			return false;
+		// call each invoker, remove the ones whose tracked object is gone
+		_invokers.visit([this, &signal](const InvokerType& invoker) {
 
-		return std::find(_invokers.begin(), _invokers.end(), CallbackInvokerType(*p)) != _invokers.end();
+			return invokeOrRemove(invoker, signal);
+		});
 	}
 
-	void addInvoker(CallbackInvokerType&& invoker) {
+	void send(SignalType* first, SignalType* last) {
+
+#if SIGNALS_INSTRUMENTATION
+		statistics().recordEmit(numTargets());
+#endif
+
+		_invokers.visit([this, first, last](const InvokerType& invoker) {
 
-		_invokers.push_back(std::forward<CallbackInvokerType>(invoker));
+			return invokeOrRemove(invoker, first, last);
+		});
 	}
 
-	void removeInvoker(const CallbackInvokerType& invoker) {
+	void sendReadOnly(const SignalType& signal) {
+
+#if SIGNALS_INSTRUMENTATION
+		statistics().recordEmit(numTargets());
+#endif
+
+		// shared by all callbacks that might modify the signal, created when 
+		// the first of them is called
+		boost::optional<SignalType> copy;
 
-		auto i = std::find(_invokers.begin(), _invokers.end(), invoker);
+		_invokers.visit([this, &signal, &copy](const InvokerType& invoker) {
 
-		if (i != _invokers.end())
-			_invokers.erase(i);
+			return invokeOrRemove(invoker, argument(invoker, signal, copy));
+		});
 	}
 
-	void send(SignalType& signal) {
+	/**
+	 * Get the signal to pass to an invoker for a read-only send.
+	 */
+	template <typename InvokerType>
+	static SignalType& argument(const InvokerType& invoker, const SignalType& signal, boost::optional<SignalType>& copy) {
 
-		// for each callback invoker
-		for (auto& invoker : _invokers)
-			if (!invoker(signal))
-				_staleInvokers.push_back(&invoker);
+		// the invoker promised not to modify the signal
+		if (invoker.isReadOnly())
+			return const_cast<SignalType&>(signal);
 
-		if (_staleInvokers.size() == 0)
-			return;
+		if (!copy)
+			copy = signal;
 
-		// for each stale invoker
-		for (auto* invoker : _staleInvokers) {
+		return *copy;
+	}
+
+	/**
+	 * Call an invoker that might fail because its tracked object does not 
+	 * exist anymore.
+	 *
+	 * @return false, if the invoker failed and should be removed.
+	 */
+	template <typename InvokerType, typename... Args>
+	bool invokeOrRemove(const InvokerType& invoker, Args&&... args) {
 
-			// remove it
-			removeInvoker(*invoker);
+		if (invoker(std::forward<Args>(args)...))
+			return true;
 
-			LOG_ALL(signalslog) << "removed stale invoker " << typeName(invoker) << std::endl;
-		}
+		SIGNALS_LOG_CONNECTIONS(signalslog) << "removing stale invoker " << typeName(invoker) << std::endl;
 
-		// clear stale invokers
-		_staleInvokers.clear();
+#if SIGNALS_INSTRUMENTATION
+		statistics().recordStaleRemoved();
+#endif
+
+		return false;
 	}
 
-	// list of callback invokers
-	std::vector<CallbackInvokerType> _invokers;
+	// the number of invokers stored inside the slot
+	static const unsigned int InlineTargets = 2;
 
-	// list of callback invokers that failed to lock and should be removed
-	std::vector<CallbackInvokerType*> _staleInvokers;
+	// the invokers of all callbacks, in the order of connection
+	typename ThreadingPolicy::template Invokers<InvokerType, InlineTargets> _invokers;
 
-	// mutex to prevent concurrent access to the invoker list
-	boost::mutex _mutex;
+	// delivers signals to the invokers, declared last to be destructed (and
+	// finish pending deliveries) first
+	typename DispatchPolicy::template Dispatcher<SignalType> _dispatcher;
 };
 
+#if !SIGNALS_INSTRUMENTATION
+// There are many more slots than callbacks or receivers. Keep them small, an 
+// empty Slot<Signal> takes 17 pointers on 64-bit platforms.
+static_assert(
+		sizeof(Slot<Signal>) <= 18*sizeof(void*),
+		"Slot grew, check the layout of the invoker list");
+#endif
+
 } // namespace signals
 
 #endif // SIGNALS_SLOT_H__
@@ -1,6 +1,12 @@
 #ifndef SIGNALS_SLOT_BASE_H__
 #define SIGNALS_SLOT_BASE_H__
 
+#include <cstddef>
+#include <cstdint>
+
+#include "Instrumentation.h"
+#include "SignalTypes.h"
+
 namespace signals {
 
 // forward declarations
@@ -12,7 +18,30 @@ class SlotBase {
 
 public:
 
-	virtual ~SlotBase() {}
+	/**
+	 * @param signalType
+	 *              The type of the signals sent by this slot.
+	 *
+	 * @param name
+	 *              Optional mangled type name of the most derived class (as 
+	 *              returned by typeid().name()), reported by Instrumentation.
+	 */
+	SlotBase(SignalTypeId signalType, const char* name = 0) :
+		_signalType(signalType) {
+
+#if SIGNALS_INSTRUMENTATION
+		Instrumentation::registerSlot(*this, name);
+#else
+		(void)name;
+#endif
+	}
+
+	virtual ~SlotBase() {
+
+#if SIGNALS_INSTRUMENTATION
+		Instrumentation::unregisterSlot(*this);
+#endif
+	}
 
 	/**
 	 * Connect this slot to a receiver.
@@ -36,6 +65,33 @@ public:
 	 */
 	virtual bool removeCallback(CallbackBase& callback) = 0;
 
+	/**
+	 * Remove a connection that was established via a connection handle, see 
+	 * Connection.
+	 *
+	 * @return true, if the connection still existed.
+	 */
+	virtual bool removeConnection(std::uint64_t /*id*/) {
+
+		return false;
+	}
+
+	/**
+	 * Returns true, if the given callback is connected to this slot.
+	 */
+	virtual bool isConnected(CallbackBase& /*callback*/) {
+
+		return false;
+	}
+
+	/**
+	 * Get the number of callbacks this slot sends to.
+	 */
+	virtual size_t numTargets() const {
+
+		return 0;
+	}
+
 	/**
 	 * Comparison operator that sorts slots according to their specificity:
 	 *
@@ -46,23 +102,37 @@ public:
 		// Return true, if the other slot can send our signals as well. This
 		// means that our signal type ≤ other signal type, i.e., we are more
 		// specific.
-		return other.canSend(createSignal());
+		return SignalTypes::isCompatible(_signalType, other._signalType);
 	}
 
 	/**
-	 * Create a reference signal for run-time type inference. This reference is
-	 * used to find compatible pairs of slots and callbacks.
+	 * Get the id of the signal type this slot sends.
 	 */
-	virtual const Signal& createSignal() const = 0;
+	SignalTypeId getSignalType() const {
 
-protected:
+		return _signalType;
+	}
 
 	/**
-	 * Return true, if the passed signal can be cast to the signal type this
-	 * slot provides. This is to determine whether a slot can send a signal of
-	 * the given type.
+	 * Create a reference signal for run-time type inference. Compatible pairs
+	 * of slots and callbacks are found via their signal type ids, see
+	 * SignalTypes.
 	 */
-	virtual bool canSend(const Signal& signal) const = 0;
+	virtual const Signal& createSignal() const = 0;
+
+#if SIGNALS_INSTRUMENTATION
+	SlotStatistics& statistics() { return _statistics; }
+	const SlotStatistics& statistics() const { return _statistics; }
+#endif
+
+private:
+
+#if SIGNALS_INSTRUMENTATION
+	SlotStatistics _statistics;
+#endif
+
+	// the signal type this slot sends
+	SignalTypeId _signalType;
 };
 
 } // namespace signals
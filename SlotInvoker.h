@@ -0,0 +1,204 @@
+#ifndef SIGNALS_SLOT_INVOKER_H__
+#define SIGNALS_SLOT_INVOKER_H__
+
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <boost/intrusive_ptr.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/smart_ptr/intrusive_ref_counter.hpp>
+
+#include "CallbackTracking.h"
+#include "Logging.h"
+#include "ReceiverAffinity.h"
+
+namespace signals {
+
+/**
+ * The invoker of a callback as it is stored in slots. Wraps the invoker of the 
+ * callback and, for callbacks with a tracking policy other than NoTracking or 
+ * with an affinity to a receiver's thread (see Receiver::setExecutor()), a 
+ * pointer to their binding. The wrapped invoker is only called if the tracker 
+ * can be locked. Signals for callbacks with an affinity that are sent from 
+ * other threads are copied and delivered in the owner thread, the tracker is 
+ * locked at the time of delivery.
+ *
+ * Slots keep all invokers in a single list in the order of connection, such 
+ * that callbacks of a receiver are called by precedence regardless of their 
+ * tracking and affinity. Sending to other callbacks only tests for the missing 
+ * binding.
+ */
+template <typename InvokerType>
+class SlotInvoker {
+
+public:
+
+	typedef typename InvokerType::CallbackBaseType CallbackBaseType;
+
+	SlotInvoker(
+			InvokerType&& invoker,
+			const CallbackTracker* tracker = 0,
+			boost::shared_ptr<ReceiverAffinity> affinity = boost::shared_ptr<ReceiverAffinity>()) :
+		_invoker(std::move(invoker)),
+		_binding(tracker || affinity ? new Binding(tracker, affinity) : 0) {}
+
+	/**
+	 * Send a signal via this invoker.
+	 *
+	 * @return false, if the tracked object does not exist anymore.
+	 */
+	template <typename T>
+	bool operator()(T& signal) const {
+
+		if (!_binding)
+			return _invoker(signal);
+
+		if (!_binding->affinity || _binding->affinity->isOwnerThread())
+			return invoke(signal);
+
+		if (expired())
+			return false;
+
+		post(signal, std::is_copy_constructible<T>());
+
+		return true;
+	}
+
+	/**
+	 * Send a batch of signals via this invoker. The tracker is locked only 
+	 * once for the whole batch, batches from other threads than the owner 
+	 * thread of an affinity are delivered as a whole.
+	 */
+	template <typename T>
+	bool operator()(T* first, T* last) const {
+
+		if (!_binding)
+			return _invoker(first, last);
+
+		if (!_binding->affinity || _binding->affinity->isOwnerThread())
+			return invoke(first, last);
+
+		if (expired())
+			return false;
+
+		post(first, last, std::is_copy_constructible<T>());
+
+		return true;
+	}
+
+	bool isReadOnly() const {
+
+		return _invoker.isReadOnly();
+	}
+
+	/**
+	 * Returns true, if the tracked object does not exist anymore.
+	 */
+	bool expired() const {
+
+		return _binding && _binding->isTracked && _binding->tracker.expired();
+	}
+
+	/**
+	 * Comparison operator. Two slot invokers are considered equal, if their 
+	 * wrapped invokers are.
+	 */
+	bool operator==(const SlotInvoker<InvokerType>& other) const {
+
+		return _invoker == other._invoker;
+	}
+
+private:
+
+	/**
+	 * The tracker and affinity of a callback, shared by all copies of the 
+	 * invoker.
+	 */
+	struct Binding : public boost::intrusive_ref_counter<Binding> {
+
+		Binding(const CallbackTracker* tracker_, boost::shared_ptr<ReceiverAffinity> affinity_) :
+			affinity(affinity_),
+			isTracked(tracker_ != 0) {
+
+			if (tracker_)
+				tracker = *tracker_;
+		}
+
+		CallbackTracker                     tracker;
+		boost::shared_ptr<ReceiverAffinity> affinity;
+		bool                                isTracked;
+	};
+
+	template <typename T>
+	bool invoke(T& signal) const {
+
+		if (!_binding->isTracked)
+			return _invoker(signal);
+
+		CallbackTracker::Lock lock = _binding->tracker.lock();
+
+		if (!lock)
+			return false;
+
+		return _invoker(signal);
+	}
+
+	template <typename T>
+	bool invoke(T* first, T* last) const {
+
+		if (!_binding->isTracked)
+			return _invoker(first, last);
+
+		CallbackTracker::Lock lock = _binding->tracker.lock();
+
+		if (!lock)
+			return false;
+
+		return _invoker(first, last);
+	}
+
+	template <typename T>
+	void post(T& signal, std::true_type) const {
+
+		SlotInvoker invoker(*this);
+
+		_binding->affinity->post([invoker, signal]() mutable { invoker.invoke(signal); });
+	}
+
+	template <typename T>
+	void post(T* first, T* last, std::true_type) const {
+
+		SlotInvoker invoker(*this);
+		std::shared_ptr<std::vector<T> > batch = std::make_shared<std::vector<T> >(first, last);
+
+		_binding->affinity->post([invoker, batch]() { invoker.invoke(batch->data(), batch->data() + batch->size()); });
+	}
+
+	// signals that can not be copied are delivered in the sending thread
+	template <typename T>
+	void post(T& signal, std::false_type) const {
+
+		LOG_ERROR(signalslog) << typeName(signal) << " can not be copied, delivering in the sending thread" << std::endl;
+
+		invoke(signal);
+	}
+
+	template <typename T>
+	void post(T* first, T* last, std::false_type) const {
+
+		LOG_ERROR(signalslog) << typeName(*first) << " can not be copied, delivering in the sending thread" << std::endl;
+
+		invoke(first, last);
+	}
+
+	InvokerType _invoker;
+
+	// the tracker and affinity of the callback, empty for untracked callbacks 
+	// without affinity
+	boost::intrusive_ptr<const Binding> _binding;
+};
+
+} // namespace signals
+
+#endif // SIGNALS_SLOT_INVOKER_H__
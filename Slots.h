@@ -1,6 +1,10 @@
 #ifndef SIGNALS_SLOTS_H__
 #define SIGNALS_SLOTS_H__
 
+#include <cassert>
+#include <cstdint>
+#include <new>
+#include <type_traits>
 #include <vector>
 
 #include "Slot.h"
@@ -16,7 +20,8 @@ public:
 	/**
 	 * Create a new slot.
 	 *
-	 * @return The current number of slots.
+	 * @return The index of the new slot. Indices of other slots are not 
+	 *         affected by adding or removing slots.
 	 */
 	virtual unsigned int addSlot() = 0;
 
@@ -30,66 +35,230 @@ public:
 	 */
 	virtual void clear() = 0;
 
+	/**
+	 * Get an upper bound for the indices of the slots. Indices of removed slots 
+	 * stay unused until they get reused, use isUsed() when iterating.
+	 */
+	virtual unsigned int indexBound() const = 0;
+
+	/**
+	 * Returns true, if the given index refers to an existing slot.
+	 */
+	virtual bool isUsed(unsigned int i) const = 0;
+
+	/**
+	 * Get the slot with the given index, which has to be used.
+	 */
 	virtual SlotBase& operator[](unsigned int i) = 0;
 };
 
+/**
+ * Identifies a slot in Slots. A handle becomes invalid when its slot gets 
+ * removed, even if the slot's index gets reused later. Default constructed 
+ * handles are invalid.
+ */
+struct SlotHandle {
+
+	SlotHandle() :
+		index(0),
+		generation(0) {}
+
+	SlotHandle(std::uint32_t index_, std::uint32_t generation_) :
+		index(index_),
+		generation(generation_) {}
+
+	std::uint32_t index;
+	std::uint32_t generation;
+};
+
+/**
+ * A dynamic number of slots for signals of type SignalType. Slots are 
+ * constructed in place in chunks of contiguous memory and never move, such 
+ * that connections to them stay valid. Indices of removed slots get reused.
+ */
 template <typename SignalType>
 class Slots : public SlotsBase {
 
 	// TODO: ensure that SignalType is default constructible
 
+	typedef Slot<SignalType> SlotType;
+
+	// the number of slots per chunk of memory
+	static const unsigned int ChunkSize = 64;
+
+	struct Chunk {
+
+		typename std::aligned_storage<sizeof(SlotType), alignof(SlotType)>::type slots[ChunkSize];
+	};
+
 public:
 
+	Slots() :
+		_size(0) {}
+
 	virtual ~Slots() {
 
-		for (unsigned int i = 0; i < _slots.size(); i++)
-			delete _slots[i];
+		clear();
+
+		for (Chunk* chunk : _chunks)
+			delete chunk;
 	}
 
 	unsigned int addSlot() {
 
-		_slots.push_back(new Slot<SignalType>());
+		return add().index;
+	}
 
-		return _slots.size() - 1;
+	/**
+	 * Create a new slot.
+	 *
+	 * @return A handle to the new slot.
+	 */
+	SlotHandle add() {
+
+		std::uint32_t i;
+
+		if (_free.empty()) {
+
+			i = _generations.size();
+
+			if (i%ChunkSize == 0)
+				_chunks.push_back(new Chunk());
+
+			_generations.push_back(0);
+
+		} else {
+
+			i = _free.back();
+			_free.pop_back();
+		}
+
+		new (address(i)) SlotType();
+
+		_generations[i]++;
+		_size++;
+
+		return SlotHandle(i, _generations[i]);
 	}
 
 	void removeSlot(unsigned int i) {
 
-		delete _slots[i];
+		if (!isUsed(i))
+			return;
+
+		address(i)->~SlotType();
 
-		_slots.erase(_slots.begin() + i);
+		_generations[i]++;
+		_free.push_back(i);
+		_size--;
+	}
+
+	/**
+	 * Remove the slot of a handle.
+	 *
+	 * @return false, if the handle was not valid.
+	 */
+	bool remove(const SlotHandle& handle) {
+
+		if (!isValid(handle))
+			return false;
+
+		removeSlot(handle.index);
+
+		return true;
 	}
 
 	void clear() {
 
-		for (unsigned int i = 0; i < _slots.size(); i++)
-			delete _slots[i];
+		for (unsigned int i = 0; i < _generations.size(); i++)
+			removeSlot(i);
+	}
+
+	/**
+	 * Get the number of slots. This is not a bound for their indices, see 
+	 * indexBound().
+	 */
+	unsigned int size() const {
+
+		return _size;
+	}
+
+	unsigned int indexBound() const {
+
+		return _generations.size();
+	}
+
+	bool isUsed(unsigned int i) const {
+
+		// odd generations mark used indices
+		return i < _generations.size() && (_generations[i] & 1);
+	}
+
+	/**
+	 * Returns true, if the handle refers to an existing slot.
+	 */
+	bool isValid(const SlotHandle& handle) const {
+
+		return handle.index < _generations.size() && _generations[handle.index] == handle.generation;
+	}
+
+	/**
+	 * Get the slot of a handle.
+	 *
+	 * @return 0, if the handle is not valid.
+	 */
+	SlotType* get(const SlotHandle& handle) {
+
+		if (!isValid(handle))
+			return 0;
 
-		_slots.clear();
+		return address(handle.index);
 	}
 
-	unsigned int size() {
+	SlotType& operator[](unsigned int i) {
+
+		assert(isUsed(i));
 
-		return _slots.size();
+		return *address(i);
 	}
 
-	Slot<SignalType>& operator[](unsigned int i) {
+	const SlotType& operator[](unsigned int i) const {
 
-		return *_slots[i];
+		assert(isUsed(i));
+
+		return *address(i);
 	}
 
-	const Slot<SignalType>& operator[](unsigned int i) const {
+	/**
+	 * Send a signal on all slots, in the order of their indices.
+	 */
+	void broadcast(SignalType& signal) {
 
-		return *_slots[i];
+		for (unsigned int i = 0; i < _generations.size(); i++)
+			if (isUsed(i))
+				(*address(i))(signal);
 	}
 
 private:
 
-	std::vector<Slot<SignalType>*> _slots;
+	SlotType* address(unsigned int i) const {
+
+		return reinterpret_cast<SlotType*>(&_chunks[i/ChunkSize]->slots[i%ChunkSize]);
+	}
+
+	// chunks of memory for the slots
+	std::vector<Chunk*> _chunks;
+
+	// the generation of each index
+	std::vector<std::uint32_t> _generations;
+
+	// unused indices
+	std::vector<std::uint32_t> _free;
+
+	// the number of slots
+	unsigned int _size;
 };
 
 } // namespace signals
 
 #endif // SIGNALS_SLOTS_H__
-
-
@@ -0,0 +1,149 @@
+#ifndef SIGNALS_SMALL_VECTOR_H__
+#define SIGNALS_SMALL_VECTOR_H__
+
+#include <algorithm>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <boost/noncopyable.hpp>
+
+namespace signals {
+
+/**
+ * Uninitialized storage for N elements of type T, inside the object.
+ */
+template <typename T, unsigned int N>
+class InlineStorage {
+
+protected:
+
+	T* inlineData() {
+
+		return reinterpret_cast<T*>(_elements);
+	}
+
+private:
+
+	typename std::aligned_storage<sizeof(T), std::alignment_of<T>::value>::type _elements[N];
+};
+
+/**
+ * Empty specialization, does not add to the size of a SmallVector.
+ */
+template <typename T>
+class InlineStorage<T, 0> {
+
+protected:
+
+	T* inlineData() {
+
+		return 0;
+	}
+};
+
+/**
+ * Vector that keeps up to N elements inside the object and moves them to the
+ * heap only when it grows beyond that. Provides the subset of std::vector
+ * needed by the threading policies. Elements are moved, never copied.
+ */
+template <typename T, unsigned int N>
+class SmallVector : private InlineStorage<T, N>, public boost::noncopyable {
+
+public:
+
+	typedef T*       iterator;
+	typedef const T* const_iterator;
+
+	SmallVector() :
+		_data(this->inlineData()),
+		_size(0),
+		_capacity(N) {}
+
+	~SmallVector() {
+
+		clear();
+		deallocate();
+	}
+
+	void push_back(T&& value) {
+
+		if (_size == _capacity)
+			grow();
+
+		new (_data + _size) T(std::move(value));
+		_size++;
+	}
+
+	/**
+	 * Remove the elements in [first, last), moving the following ones to the
+	 * front.
+	 */
+	void erase(iterator first, iterator last) {
+
+		iterator newEnd = std::move(last, end(), first);
+
+		for (iterator i = newEnd; i != end(); ++i)
+			i->~T();
+
+		_size = newEnd - begin();
+	}
+
+	void clear() {
+
+		erase(begin(), end());
+	}
+
+	std::size_t size() const { return _size; }
+
+	bool empty() const { return _size == 0; }
+
+	/**
+	 * Returns true, if the elements are stored inside the object.
+	 */
+	bool isInline() const { return _capacity == N; }
+
+	iterator begin() { return _data; }
+	iterator end()   { return _data + _size; }
+
+	const_iterator begin() const { return _data; }
+	const_iterator end()   const { return _data + _size; }
+
+	T&       operator[](std::size_t i)       { return _data[i]; }
+	const T& operator[](std::size_t i) const { return _data[i]; }
+
+private:
+
+	void grow() {
+
+		std::uint32_t capacity = std::max(2*_capacity, 1u);
+
+		T* data = static_cast<T*>(::operator new(capacity*sizeof(T)));
+
+		for (std::uint32_t i = 0; i < _size; i++) {
+
+			new (data + i) T(std::move(_data[i]));
+			_data[i].~T();
+		}
+
+		deallocate();
+
+		_data     = data;
+		_capacity = capacity;
+	}
+
+	void deallocate() {
+
+		if (!isInline())
+			::operator delete(_data);
+	}
+
+	T* _data;
+
+	std::uint32_t _size;
+	std::uint32_t _capacity;
+};
+
+} // namespace signals
+
+#endif // SIGNALS_SMALL_VECTOR_H__
@@ -0,0 +1,146 @@
+#include "ThreadPool.h"
+
+namespace signals {
+
+namespace {
+
+	// the pool and queue of the current thread, if it is a worker
+	thread_local ThreadPool*  currentPool  = 0;
+	thread_local unsigned int currentQueue = 0;
+}
+
+ThreadPool::ThreadPool(unsigned int numWorkers) :
+	_next(0),
+	_numPending(0),
+	_numSleeping(0),
+	_stop(false) {
+
+	if (numWorkers == 0)
+		numWorkers = 1;
+
+	for (unsigned int i = 0; i < numWorkers; i++)
+		_queues.emplace_back(new Queue());
+
+	for (unsigned int i = 0; i < numWorkers; i++)
+		_workers.create_thread([this, i]{ work(i); });
+}
+
+ThreadPool::~ThreadPool() {
+
+	{
+		boost::mutex::scoped_lock lock(_sleepMutex);
+		_stop = true;
+	}
+
+	_wakeUp.notify_all();
+	_workers.join_all();
+}
+
+void
+ThreadPool::post(task_type task) {
+
+	unsigned int queue;
+
+	if (currentPool == this)
+		queue = currentQueue;
+	else
+		queue = _next.fetch_add(1, boost::memory_order_relaxed)%_queues.size();
+
+	_numPending.fetch_add(1, boost::memory_order_seq_cst);
+
+	{
+		boost::mutex::scoped_lock lock(_queues[queue]->mutex);
+		_queues[queue]->tasks.push_back(std::move(task));
+	}
+
+	// only take the sleep mutex if there is a worker to wake up
+	if (_numSleeping.load(boost::memory_order_seq_cst) > 0) {
+
+		boost::mutex::scoped_lock lock(_sleepMutex);
+		_wakeUp.notify_one();
+	}
+}
+
+bool
+ThreadPool::tryRunOne() {
+
+	task_type task;
+
+	if (!take(currentPool == this ? currentQueue : 0, task))
+		return false;
+
+	task();
+
+	return true;
+}
+
+ThreadPool&
+ThreadPool::getDefault() {
+
+	static ThreadPool pool;
+
+	return pool;
+}
+
+void
+ThreadPool::work(unsigned int worker) {
+
+	currentPool  = this;
+	currentQueue = worker;
+
+	task_type task;
+
+	while (true) {
+
+		if (take(worker, task)) {
+
+			task();
+			task = task_type();
+			continue;
+		}
+
+		boost::mutex::scoped_lock lock(_sleepMutex);
+
+		_numSleeping.fetch_add(1, boost::memory_order_seq_cst);
+
+		while (_numPending.load(boost::memory_order_seq_cst) == 0 && !_stop)
+			_wakeUp.wait(lock);
+
+		_numSleeping.fetch_sub(1, boost::memory_order_seq_cst);
+
+		if (_stop && _numPending.load() == 0)
+			return;
+	}
+}
+
+bool
+ThreadPool::take(unsigned int queue, task_type& task) {
+
+	// own queue first
+	if (pop(*_queues[queue], task))
+		return true;
+
+	// steal from the other queues
+	for (unsigned int i = 1; i < _queues.size(); i++)
+		if (pop(*_queues[(queue + i)%_queues.size()], task))
+			return true;
+
+	return false;
+}
+
+bool
+ThreadPool::pop(Queue& queue, task_type& task) {
+
+	boost::mutex::scoped_lock lock(queue.mutex);
+
+	if (queue.tasks.empty())
+		return false;
+
+	task = std::move(queue.tasks.front());
+	queue.tasks.pop_front();
+	_numPending.fetch_sub(1, boost::memory_order_seq_cst);
+
+	return true;
+}
+
+} // namespace signals
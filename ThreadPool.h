@@ -0,0 +1,103 @@
+#ifndef SIGNALS_THREAD_POOL_H__
+#define SIGNALS_THREAD_POOL_H__
+
+#include <deque>
+#include <functional>
+#include <memory>
+#include <vector>
+#include <boost/atomic.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/thread.hpp>
+
+namespace signals {
+
+/**
+ * Work-stealing thread pool to deliver queued signals. Every worker has its 
+ * own task queue. Tasks posted from a worker go to the worker's own queue, 
+ * tasks posted from other threads are distributed round-robin. Idle workers 
+ * steal tasks from the queues of other workers. Queues are unbounded, such 
+ * that posting never blocks on slow tasks. Tasks of one queue are started in 
+ * the order they were posted, but there is no order between tasks executed 
+ * by different workers.
+ */
+class ThreadPool : public boost::noncopyable {
+
+public:
+
+	typedef std::function<void()> task_type;
+
+	/**
+	 * Create a thread pool with the given number of workers.
+	 */
+	ThreadPool(unsigned int numWorkers = boost::thread::hardware_concurrency());
+
+	/**
+	 * Stops the thread pool after all posted tasks have been processed.
+	 */
+	~ThreadPool();
+
+	/**
+	 * Post a task to be executed by one of the workers.
+	 */
+	void post(task_type task);
+
+	/**
+	 * Execute one pending task in the calling thread, if there is one. Can be 
+	 * used to help the pool while waiting for tasks to finish.
+	 *
+	 * @return true, if a task was executed.
+	 */
+	bool tryRunOne();
+
+	/**
+	 * Get the number of workers of this pool.
+	 */
+	unsigned int size() const {
+
+		return _queues.size();
+	}
+
+	/**
+	 * Get the thread pool that is used for queued slots by default.
+	 */
+	static ThreadPool& getDefault();
+
+private:
+
+	struct Queue {
+
+		boost::mutex          mutex;
+		std::deque<task_type> tasks;
+	};
+
+	void work(unsigned int worker);
+
+	// get a task, preferably from the given queue, otherwise steal one
+	bool take(unsigned int queue, task_type& task);
+
+	// get the oldest task of a queue
+	bool pop(Queue& queue, task_type& task);
+
+	std::vector<std::unique_ptr<Queue> > _queues;
+
+	boost::thread_group _workers;
+
+	// the queue to post the next task from a non-worker thread to
+	boost::atomic<unsigned int> _next;
+
+	// the number of tasks that have been posted but not taken yet
+	boost::atomic<size_t> _numPending;
+
+	// the number of workers waiting for tasks
+	boost::atomic<unsigned int> _numSleeping;
+
+	boost::atomic<bool> _stop;
+
+	// to wake up sleeping workers
+	boost::mutex              _sleepMutex;
+	boost::condition_variable _wakeUp;
+};
+
+} // namespace signals
+
+#endif // SIGNALS_THREAD_POOL_H__
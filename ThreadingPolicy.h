@@ -0,0 +1,716 @@
+#ifndef SIGNALS_THREADING_POLICY_H__
+#define SIGNALS_THREADING_POLICY_H__
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <boost/atomic.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/thread.hpp>
+
+#include "Epochs.h"
+#include "SmallVector.h"
+
+namespace signals {
+
+/**
+ * Identifies an invoker that was added to an invoker list via connect(). A 
+ * handle stays invalid once its invoker got removed, even if the handle's 
+ * index gets reused for another invoker. Default constructed handles are 
+ * invalid.
+ */
+struct InvokerHandle {
+
+	InvokerHandle() :
+		index(0),
+		generation(0) {}
+
+	InvokerHandle(std::uint32_t index_, std::uint32_t generation_) :
+		index(index_),
+		generation(generation_) {}
+
+	std::uint32_t index;
+	std::uint32_t generation;
+};
+
+/**
+ * Table of invoker handles, maps valid handles to positions in an invoker 
+ * list. Used by the threading policies.
+ */
+class InvokerHandles {
+
+public:
+
+	// marks invokers that have not been added with a handle
+	static const std::uint32_t None = 0xffffffff;
+
+	/**
+	 * Create a new handle for an invoker at the given position.
+	 */
+	InvokerHandle create(size_t position) {
+
+		std::uint32_t index;
+
+		if (_free.empty()) {
+
+			index = _entries.size();
+			_entries.push_back(Entry());
+
+		} else {
+
+			index = _free.back();
+			_free.pop_back();
+		}
+
+		_entries[index].position = position;
+
+		return InvokerHandle(index, _entries[index].generation);
+	}
+
+	/**
+	 * Get the position of the invoker of a handle.
+	 *
+	 * @return false, if the handle is not valid.
+	 */
+	bool find(const InvokerHandle& handle, size_t& position) const {
+
+		if (handle.index >= _entries.size() || _entries[handle.index].generation != handle.generation)
+			return false;
+
+		position = _entries[handle.index].position;
+
+		return true;
+	}
+
+	/**
+	 * Update the position of the invoker with the given handle index.
+	 */
+	void move(std::uint32_t index, size_t position) {
+
+		_entries[index].position = position;
+	}
+
+	/**
+	 * Invalidate all handles with the given index.
+	 */
+	void release(std::uint32_t index) {
+
+		// skip generation 0, which is never valid
+		if (++_entries[index].generation == 0)
+			_entries[index].generation = 1;
+
+		_free.push_back(index);
+	}
+
+private:
+
+	struct Entry {
+
+		Entry() : position(0), generation(1) {}
+
+		size_t        position;
+		std::uint32_t generation;
+	};
+
+	std::vector<Entry>         _entries;
+	std::vector<std::uint32_t> _free;
+};
+
+/**
+ * Threading policy for slots that are only used from a single thread (or that
+ * are synchronized externally). Invokers are kept in a vector that stores the 
+ * first InlineCapacity invokers inside the list itself. Removed invokers are 
+ * only marked as such and get compacted away during the next visit, or as 
+ * soon as they make up half of the vector.
+ */
+class SingleThreaded {
+
+public:
+
+	template <typename InvokerType, unsigned int InlineCapacity = 0>
+	class Invokers {
+
+		// marks removed invokers
+		static const std::uint32_t Removed = InvokerHandles::None - 1;
+
+		struct Entry {
+
+			Entry(InvokerType&& invoker_, std::uint32_t handle_) :
+				invoker(std::move(invoker_)),
+				handle(handle_) {}
+
+			InvokerType invoker;
+
+			// the index of the invoker's handle, None, or Removed
+			std::uint32_t handle;
+		};
+
+	public:
+
+		Invokers() :
+			_numRemoved(0) {}
+
+		/**
+		 * Add an invoker, unless an equal one is already present.
+		 *
+		 * @return true, if the invoker was added.
+		 */
+		bool add(InvokerType&& invoker) {
+
+			if (contains(invoker))
+				return false;
+
+			_entries.push_back(Entry(std::move(invoker), InvokerHandles::None));
+
+			return true;
+		}
+
+		/**
+		 * Add an invoker without checking for an equal one.
+		 *
+		 * @return A handle to remove the invoker in constant time.
+		 */
+		InvokerHandle connect(InvokerType&& invoker) {
+
+			if (!_handles)
+				_handles.reset(new InvokerHandles());
+
+			InvokerHandle handle = _handles->create(_entries.size());
+
+			_entries.push_back(Entry(std::move(invoker), handle.index));
+
+			return handle;
+		}
+
+		/**
+		 * Remove an invoker.
+		 *
+		 * @return true, if the invoker was present.
+		 */
+		bool remove(const InvokerType& invoker) {
+
+			size_t position = find(invoker);
+
+			if (position == _entries.size())
+				return false;
+
+			markRemoved(position);
+
+			return true;
+		}
+
+		/**
+		 * Remove the invoker of a handle.
+		 *
+		 * @return true, if the handle was valid.
+		 */
+		bool disconnect(const InvokerHandle& handle) {
+
+			size_t position;
+
+			if (!_handles || !_handles->find(handle, position))
+				return false;
+
+			markRemoved(position);
+
+			return true;
+		}
+
+		bool contains(const InvokerType& invoker) const {
+
+			return find(invoker) != _entries.size();
+		}
+
+		size_t size() const {
+
+			return _entries.size() - _numRemoved;
+		}
+
+		/**
+		 * Call visitor(invoker) for each invoker. Invokers for which the
+		 * visitor returns false are considered stale and will be removed.
+		 * Stale invokers are compacted away in the same pass, such that
+		 * removing many of them stays linear in the number of invokers.
+		 */
+		template <typename Visitor>
+		void visit(Visitor&& visitor) {
+
+			size_t position = 0;
+
+			// without removed invokers, there is nothing to compact until the 
+			// first stale invoker shows up
+			if (_numRemoved == 0) {
+
+				while (position < _entries.size() && visitor(_entries[position].invoker))
+					position++;
+
+				if (position == _entries.size())
+					return;
+
+				Entry& stale = _entries[position];
+
+				if (stale.handle != InvokerHandles::None)
+					_handles->release(stale.handle);
+
+				stale.handle = Removed;
+			}
+
+			compact([&visitor](InvokerType& invoker) { return !visitor(invoker); }, position);
+		}
+
+		/**
+		 * Remove all invokers for which isStale(invoker) returns true.
+		 *
+		 * @return The number of removed invokers.
+		 */
+		template <typename Predicate>
+		size_t removeIf(Predicate&& isStale) {
+
+			return compact(isStale);
+		}
+
+	private:
+
+		size_t find(const InvokerType& invoker) const {
+
+			for (size_t i = 0; i < _entries.size(); i++)
+				if (_entries[i].handle != Removed && _entries[i].invoker == invoker)
+					return i;
+
+			return _entries.size();
+		}
+
+		void markRemoved(size_t position) {
+
+			Entry& entry = _entries[position];
+
+			if (entry.handle != InvokerHandles::None)
+				_handles->release(entry.handle);
+
+			entry.handle = Removed;
+			_numRemoved++;
+
+			if (2*_numRemoved > _entries.size())
+				compact([](InvokerType&) { return false; });
+		}
+
+		/**
+		 * Drop all removed invokers and the ones for which isStale(invoker)
+		 * returns true in a single pass, preserving the order of the
+		 * remaining ones. Invokers before position first are kept without
+		 * calling isStale.
+		 */
+		template <typename Predicate>
+		size_t compact(Predicate&& isStale, size_t first = 0) {
+
+			size_t stale = 0;
+
+			auto write = _entries.begin() + first;
+
+			for (auto read = _entries.begin() + first; read != _entries.end(); ++read) {
+
+				if (read->handle == Removed)
+					continue;
+
+				if (isStale(read->invoker)) {
+
+					if (read->handle != InvokerHandles::None)
+						_handles->release(read->handle);
+
+					stale++;
+					continue;
+				}
+
+				if (write != read) {
+
+					*write = std::move(*read);
+
+					if (write->handle != InvokerHandles::None)
+						_handles->move(write->handle, write - _entries.begin());
+				}
+
+				++write;
+			}
+
+			_entries.erase(write, _entries.end());
+			_numRemoved = 0;
+
+			return stale;
+		}
+
+		// list of callback invokers
+		SmallVector<Entry, InlineCapacity> _entries;
+
+		// the number of entries marked as removed
+		std::uint32_t _numRemoved;
+
+		// positions of invokers added via connect(), created on first use
+		std::unique_ptr<InvokerHandles> _handles;
+	};
+};
+
+/**
+ * Threading policy for slots that send from several threads concurrently to
+ * connecting and disconnecting. Invokers are kept in an immutable snapshot
+ * that is published atomically (read-copy-update): Sending never takes a
+ * lock, it only announces itself as a reader in its thread's epoch record 
+ * (see Epochs) and reads the current snapshot. Modifications are serialized by 
+ * a mutex, copy the current snapshot, and swap in the modified copy. Replaced 
+ * snapshots are retired and freed once every reader that might have 
+ * seen them has left.
+ *
+ * Requires InvokerType to be copy constructible. Snapshots always live on the 
+ * heap, InlineCapacity is ignored.
+ */
+class MultiThreaded {
+
+public:
+
+	template <typename InvokerType, unsigned int InlineCapacity = 0>
+	class Invokers {
+
+		struct Entry {
+
+			Entry(InvokerType&& invoker_, std::uint32_t handle_) :
+				invoker(std::move(invoker_)),
+				handle(handle_) {}
+
+			InvokerType invoker;
+
+			// the index of the invoker's handle, or None
+			std::uint32_t handle;
+		};
+
+		typedef std::vector<Entry> snapshot_type;
+
+	public:
+
+		Invokers() :
+			_snapshot(empty()),
+			_size(0) {}
+
+		~Invokers() {
+
+			// retired snapshots are owned by Epochs and don't refer to us
+			destroy(_snapshot.load());
+		}
+
+		bool add(InvokerType&& invoker) {
+
+			WriteLock lock(*this);
+
+			const snapshot_type& current = *_snapshot.load();
+
+			for (const auto& entry : current)
+				if (entry.invoker == invoker)
+					return false;
+
+			append(Entry(std::move(invoker), InvokerHandles::None), lock);
+
+			return true;
+		}
+
+		/**
+		 * Add an invoker without checking for an equal one.
+		 *
+		 * @return A handle to remove the invoker without comparing invokers.
+		 */
+		InvokerHandle connect(InvokerType&& invoker) {
+
+			WriteLock lock(*this);
+
+			if (!_handles)
+				_handles.reset(new InvokerHandles());
+
+			InvokerHandle handle = _handles->create(0);
+
+			append(Entry(std::move(invoker), handle.index), lock);
+
+			return handle;
+		}
+
+		bool remove(const InvokerType& invoker) {
+
+			WriteLock lock(*this);
+
+			return removeLocked([&invoker](const Entry& entry) { return entry.invoker == invoker; }, lock) > 0;
+		}
+
+		/**
+		 * Remove the invoker of a handle.
+		 *
+		 * @return true, if the handle was valid.
+		 */
+		bool disconnect(const InvokerHandle& handle) {
+
+			WriteLock lock(*this);
+
+			size_t position;
+
+			if (!_handles || !_handles->find(handle, position))
+				return false;
+
+			return removeLocked([&handle](const Entry& entry) { return entry.handle == handle.index; }, lock) > 0;
+		}
+
+		bool contains(const InvokerType& invoker) const {
+
+			ReadGuard guard(*this);
+
+			for (const auto& entry : *guard)
+				if (entry.invoker == invoker)
+					return true;
+
+			return false;
+		}
+
+		size_t size() const {
+
+			return _size.load(boost::memory_order_relaxed);
+		}
+
+		/**
+		 * Call visitor(invoker) for each invoker of the current snapshot.
+		 * Invokers for which the visitor returns false are considered stale
+		 * and will be removed. Only the removal of stale invokers takes the
+		 * writer lock.
+		 */
+		template <typename Visitor>
+		void visit(Visitor&& visitor) {
+
+			// don't announce a reader for empty lists, a concurrent connect 
+			// is not ordered with this visit anyway
+			if (size() == 0)
+				return;
+
+			std::vector<size_t> stale;
+
+			ReadGuard guard(*this);
+
+			for (size_t i = 0; i < guard->size(); i++)
+				if (!visitor((*guard)[i].invoker))
+					stale.push_back(i);
+
+			if (stale.size() == 0)
+				return;
+
+			WriteLock lock(*this);
+
+			// The guard keeps our snapshot alive. If it is still the current
+			// one, the stale invokers can be dropped by their position in a
+			// single pass.
+			if (_snapshot.load() == &*guard) {
+
+				size_t position = 0;
+				auto nextStale = stale.begin();
+
+				removeLocked([&](const Entry&) {
+
+					if (nextStale == stale.end() || *nextStale != position++)
+						return false;
+
+					++nextStale;
+					return true;
+				}, lock);
+
+				return;
+			}
+
+			// somebody else modified the invokers in the meantime
+			std::vector<InvokerType> staleInvokers;
+			staleInvokers.reserve(stale.size());
+			for (size_t i : stale)
+				staleInvokers.push_back((*guard)[i].invoker);
+
+			removeLocked([&staleInvokers](const Entry& entry) {
+
+				return std::find(staleInvokers.begin(), staleInvokers.end(), entry.invoker) != staleInvokers.end();
+			}, lock);
+		}
+
+		/**
+		 * Remove all invokers for which isStale(invoker) returns true.
+		 *
+		 * @return The number of removed invokers.
+		 */
+		template <typename Predicate>
+		size_t removeIf(Predicate&& isStale) {
+
+			WriteLock lock(*this);
+
+			return removeLocked([&isStale](const Entry& entry) { return isStale(entry.invoker); }, lock);
+		}
+
+	private:
+
+		/**
+		 * Keeps the snapshot that was current at construction alive for the 
+		 * lifetime of the guard and provides access to it. Readers only 
+		 * announce themselves in their thread's epoch record, concurrent 
+		 * readers don't write to shared memory except for the occasional 
+		 * collection of retired snapshots.
+		 */
+		class ReadGuard {
+
+		public:
+
+			ReadGuard(const Invokers& invokers) :
+				_snapshot(invokers._snapshot.load(boost::memory_order_acquire)) {}
+
+			const snapshot_type* operator->() const { return _snapshot; }
+			const snapshot_type& operator*() const { return *_snapshot; }
+
+		private:
+
+			// entered before the snapshot is loaded
+			Epochs::Guard _epoch;
+
+			const snapshot_type* _snapshot;
+		};
+
+		/**
+		 * Serializes modifications of the invoker list via _mutex. The 
+		 * snapshot replaced while the lock is held is retired only after the 
+		 * mutex got released: retiring runs the deleters of older snapshots, 
+		 * which might destruct tracked objects that modify this or other 
+		 * slots. Every modification replaces at most one snapshot.
+		 */
+		class WriteLock : public boost::noncopyable {
+
+		public:
+
+			WriteLock(Invokers& invokers) :
+				_lock(invokers._mutex),
+				_replaced(0) {}
+
+			~WriteLock() {
+
+				_lock.unlock();
+
+				if (_replaced) {
+
+					snapshot_type* replaced = _replaced;
+					Epochs::retire([replaced]{ delete replaced; });
+				}
+			}
+
+			/**
+			 * Retire the given snapshot after the lock got released.
+			 */
+			void retire(snapshot_type* snapshot) {
+
+				_replaced = snapshot;
+			}
+
+		private:
+
+			boost::unique_lock<boost::mutex> _lock;
+
+			snapshot_type* _replaced;
+		};
+
+		/**
+		 * Publish a copy of the current snapshot with an additional entry.
+		 */
+		void append(Entry&& entry, WriteLock& lock) {
+
+			const snapshot_type& current = *_snapshot.load();
+
+			snapshot_type* next = new snapshot_type();
+			next->reserve(current.size() + 1);
+			next->insert(next->end(), current.begin(), current.end());
+			next->push_back(std::move(entry));
+
+			publish(next, lock);
+		}
+
+		/**
+		 * Publish a copy of the current snapshot without the entries for which
+		 * isRemoved(entry) returns true.
+		 *
+		 * @return The number of removed entries.
+		 */
+		template <typename Predicate>
+		size_t removeLocked(Predicate&& isRemoved, WriteLock& lock) {
+
+			const snapshot_type& current = *_snapshot.load();
+
+			snapshot_type* next = new snapshot_type();
+			next->reserve(current.size());
+
+			for (const auto& entry : current) {
+
+				if (!isRemoved(entry)) {
+
+					next->push_back(entry);
+					continue;
+				}
+
+				if (entry.handle != InvokerHandles::None)
+					_handles->release(entry.handle);
+			}
+
+			size_t removed = current.size() - next->size();
+
+			if (removed == 0) {
+
+				delete next;
+				return 0;
+			}
+
+			publish(next, lock);
+
+			return removed;
+		}
+
+		/**
+		 * Swap in a new snapshot and retire the old one when the lock gets 
+		 * released. The old snapshot gets destroyed once the last reader that 
+		 * might have seen it left its guard.
+		 */
+		void publish(snapshot_type* next, WriteLock& lock) {
+
+			_size.store(next->size(), boost::memory_order_relaxed);
+
+			snapshot_type* previous = _snapshot.exchange(next, boost::memory_order_seq_cst);
+
+			if (previous != empty())
+				lock.retire(previous);
+		}
+
+		/**
+		 * The snapshot of lists without invokers, shared by all lists of this 
+		 * type such that empty lists do not allocate.
+		 */
+		static snapshot_type* empty() {
+
+			static snapshot_type snapshot;
+
+			return &snapshot;
+		}
+
+		static void destroy(snapshot_type* snapshot) {
+
+			if (snapshot != empty())
+				delete snapshot;
+		}
+
+		// the current snapshot of invokers
+		boost::atomic<snapshot_type*> _snapshot;
+
+		// the size of the current snapshot
+		boost::atomic<size_t> _size;
+
+		// handles of invokers added via connect(), created on first use and 
+		// modified under _mutex
+		std::unique_ptr<InvokerHandles> _handles;
+
+		// mutex to serialize modifications of the invoker list, see WriteLock
+		boost::mutex _mutex;
+	};
+};
+
+} // namespace signals
+
+#endif // SIGNALS_THREADING_POLICY_H__
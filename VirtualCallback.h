@@ -1,6 +1,8 @@
 #ifndef SIGNALS_VIRTUAL_CALLBACK_H__
 #define SIGNALS_VIRTUAL_CALLBACK_H__
 
+#include <typeinfo>
+
 #include "CallbackBase.h"
 #include "CallbackInvocation.h"
 #include "VirtualCallbackBase.h"
@@ -40,9 +42,11 @@ public:
 	 *              SignalType.
 	 */
 	VirtualCallback(HandlerType* handler, CallbackInvocation invocation = Exclusive) :
-		VirtualCallbackBase<typename HandlerType::HandlerBaseType>([this](Signal& signal){ static_cast<HandlerType*>(this->handler())->onSignal(static_cast<SignalType&>(signal)); }, handler),
+		VirtualCallbackBase<typename HandlerType::HandlerBaseType>(SignalTraits<SignalType>::id(), handler, typeid(VirtualCallback).name()),
 		_handler(handler) {
 
+		this->setDelegate(Delegate::fromMethod<SignalType, HandlerType, &HandlerType::onSignal>(*handler));
+
 		if (invocation == Transparent)
 			this->setTransparent();
 	}
@@ -56,9 +60,7 @@ public:
 	 */
 	bool connect(SlotBase& slot) {
 
-		const Signal& reference = slot.createSignal();
-
-		if (!accepts(reference))
+		if (!this->accepts(slot.getSignalType()))
 			return false;
 
 		return slot.addCallback(*this);
@@ -73,9 +75,7 @@ public:
 	 */
 	bool disconnect(SlotBase& slot) {
 
-		const Signal& reference = slot.createSignal();
-
-		if (!accepts(reference))
+		if (!this->accepts(slot.getSignalType()))
 			return false;
 
 		return slot.removeCallback(*this);
@@ -83,15 +83,6 @@ public:
 
 private:
 
-	/**
-	 * Return true if this callback can accept the provided signal, i.e., if the 
-	 * signal's type is equal to or a superclass of SignalType.
-	 */
-	bool accepts(const Signal& signal) const {
-
-		return dynamic_cast<const SignalType*>(&signal);
-	}
-
 	const Signal& createSignal() const {
 
 		return SignalTraits<SignalType>::Reference;
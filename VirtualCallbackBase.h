@@ -10,8 +10,8 @@ class VirtualCallbackBase : public CallbackBase {
 
 public:
 
-	VirtualCallbackBase(std::function<void(Signal&)> relayFunction, HandlerBaseType* handler) :
-		CallbackBase(relayFunction),
+	VirtualCallbackBase(SignalTypeId signalType, HandlerBaseType* handler, const char* name = 0) :
+		CallbackBase(signalType, name),
 		_handler(handler) {}
 
 	HandlerBaseType* handler() const { return _handler; }
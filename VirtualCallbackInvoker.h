@@ -1,14 +1,19 @@
 #ifndef SIGNALS_VIRTUAL_CALLBACK_INVOKER_H__
 #define SIGNALS_VIRTUAL_CALLBACK_INVOKER_H__
 
+#include "Delegate.h"
 #include "Signal.h"
+#include "SignalTraits.h"
 #include "VirtualCallbackBase.h"
 
 namespace signals {
 
 /**
  * Specialized functor to send signals of type SignalType to a callback that is 
- * described by a virtual function.
+ * described by a virtual function. If the handler of the callback expects a 
+ * more general signal type than SignalType, the invoker relays signals via the 
+ * callback's delegate instead. The delegate is stored in the invoker, such 
+ * that connecting and disconnecting never allocates.
  *
  * Concept Handler:
  *
@@ -28,8 +33,7 @@ public:
 	typedef VirtualCallbackBase<HandlerBaseType>  CallbackBaseType;
 
 	VirtualCallbackInvoker() :
-		_handler(0),
-		_ownHandler(false) {}
+		_handler(0) {}
 
 	VirtualCallbackInvoker(CallbackBaseType& callback) {
 
@@ -38,59 +42,55 @@ public:
 		// SignalType, we have a match. In this case, we can assume that the 
 		// handler is of HandlerType<SignalType>.
 
-		if (const SignalType* signal = dynamic_cast<const SignalType*>(&callback.createSignal())) {
+		if (SignalTypes::isCompatible(callback.getSignalType(), SignalTraits<SignalType>::id())) {
 
 			_handler = static_cast<HandlerType*>(callback.handler());
-			_ownHandler = false;
 
 		} else {
 
-			_handler = new Relay(callback.relayFunction());
-			_ownHandler = true;
+			_handler = 0;
+			_relay   = callback.delegate();
 		}
 	}
 
 	/**
-	 * Move constructor.
+	 * Send a signal via this callback invoker.
 	 */
-	VirtualCallbackInvoker(VirtualCallbackInvoker<SignalType, HandlerType>&& other) :
-		_handler(other._handler),
-		_ownHandler(other._ownHandler) {
+	template <typename T>
+	bool operator()(T& signal) const {
+
+		if (_handler)
+			_handler->onSignal(signal);
+		else
+			_relay(signal);
 
-		other._handler = 0;
-		other._ownHandler = false;
+		return true;
 	}
 
 	/**
-	 * Move assignment.
+	 * Send a batch of signals via this callback invoker.
 	 */
-	VirtualCallbackInvoker<SignalType, HandlerType>& operator=(VirtualCallbackInvoker<SignalType, HandlerType>&& other) {
+	template <typename T>
+	bool operator()(T* first, T* last) const {
 
-		_handler = other._handler;
-		_ownHandler = other._ownHandler;
-		other._handler = 0;
-		other._ownHandler = false;
+		if (!_handler) {
 
-		return *this;
-	}
+			_relay(SignalBatch(first, last));
+			return true;
+		}
 
-	/**
-	 * Deallocate handler, if it was created by us.
-	 */
-	~VirtualCallbackInvoker() {
+		for (T* signal = first; signal != last; signal++)
+			_handler->onSignal(*signal);
 
-		if (_ownHandler)
-			delete _handler;
+		return true;
 	}
 
 	/**
-	 * Send a signal via this callback invoker.
+	 * Handlers take signals by non-const reference and might modify them.
 	 */
-	template <typename T>
-	bool operator()(T& signal) {
+	bool isReadOnly() const {
 
-		_handler->onSignal(signal);
-		return true;
+		return false;
 	}
 
 	/**
@@ -99,37 +99,17 @@ public:
 	 */
 	bool operator==(const VirtualCallbackInvoker<SignalType, HandlerType>& other) const {
 
-		if (_ownHandler != other._ownHandler)
-			return false;
-
-		return _handler == other._handler;
-
-		// TODO: for relay invokers, test target of std::function:
-		//return (_callback.get_pointer() == other._callback.get_pointer());
+		// relays are equal if they relay to the same delegate
+		return _handler == other._handler && _relay == other._relay;
 	}
 
 private:
 
-	class Relay : public HandlerType {
-
-	public:
-
-		Relay(std::function<void(Signal&)> fun) : _fun(fun) {}
-
-	private:
-
-		void onSignal(SignalType& signal) override {
-
-			_fun(signal);
-		}
-
-		std::function<void(Signal&)> _fun;
-	};
-
+	// the handler to call directly, or 0 if signals have to be relayed
 	HandlerType* _handler;
 
-	// did we create the handler?
-	bool _ownHandler;
+	// the delegate of the callback, used if there is no handler
+	Delegate _relay;
 };
 
 } // namespace signals
@@ -1,6 +1,8 @@
 #include "Slot.h"
+#include "Connection.h"
 #include "Slots.h"
 #include "Callback.h"
+#include "BatchCallback.h"
 #include "VirtualCallback.h"
 #include "VirtualCallbackInvoker.h"
 #include "Sender.h"
@@ -0,0 +1,121 @@
+#include <chrono>
+#include <ctime>
+#include <iostream>
+#include <thread>
+
+#include "Benchmark.h"
+
+namespace signals {
+namespace benchmark {
+
+namespace {
+
+	struct Registration {
+
+		std::string        name;
+		benchmark_function function;
+		long               arg;
+	};
+
+	std::vector<Registration>& registrations() {
+
+		static std::vector<Registration> registrations;
+		return registrations;
+	}
+
+	// minimal time a benchmark has to run to be reported
+	const double MinTime = 0.1;
+
+	// run a benchmark, return the real time and store the cpu time in seconds
+	double run(const Registration& registration, std::size_t iterations, double& cpuSeconds) {
+
+		State state(iterations, registration.arg);
+
+		std::clock_t cpuStart = std::clock();
+		auto start = std::chrono::steady_clock::now();
+		registration.function(state);
+		auto end = std::chrono::steady_clock::now();
+		std::clock_t cpuEnd = std::clock();
+
+		cpuSeconds = static_cast<double>(cpuEnd - cpuStart)/CLOCKS_PER_SEC;
+
+		return std::chrono::duration<double>(end - start).count();
+	}
+}
+
+int
+registerBenchmark(const std::string& name, benchmark_function function) {
+
+	Registration registration = { name, function, 0 };
+	registrations().push_back(registration);
+
+	return 0;
+}
+
+int
+registerBenchmark(const std::string& name, benchmark_function function, std::vector<long> args) {
+
+	for (long arg : args) {
+
+		Registration registration = { name + "/" + std::to_string(arg), function, arg };
+		registrations().push_back(registration);
+	}
+
+	return 0;
+}
+
+void
+runBenchmarks(const std::string& filter) {
+
+	std::cout
+			<< "{" << std::endl
+			<< "  \"context\": {" << std::endl
+			<< "    \"library\": \"signals\"," << std::endl
+			<< "    \"num_cpus\": " << std::thread::hardware_concurrency() << std::endl
+			<< "  }," << std::endl
+			<< "  \"benchmarks\": [";
+
+	bool first = true;
+
+	for (const Registration& registration : registrations()) {
+
+		if (registration.name.find(filter) == std::string::npos)
+			continue;
+
+		// increase the number of iterations until the benchmark runs long
+		// enough
+		std::size_t iterations = 1;
+		double      cpuSeconds;
+		double      seconds    = run(registration, iterations, cpuSeconds);
+
+		while (seconds < MinTime && iterations < (std::size_t(1) << 40)) {
+
+			double factor = (seconds > 0 ? 1.4*MinTime/seconds : 10);
+			if (factor > 10)
+				factor = 10;
+
+			iterations = static_cast<std::size_t>(iterations*factor) + 1;
+			seconds    = run(registration, iterations, cpuSeconds);
+		}
+
+		double ns    = seconds*1e9/iterations;
+		double cpuNs = cpuSeconds*1e9/iterations;
+
+		std::cout
+				<< (first ? "" : ",") << std::endl
+				<< "    {" << std::endl
+				<< "      \"name\": \"" << registration.name << "\"," << std::endl
+				<< "      \"iterations\": " << iterations << "," << std::endl
+				<< "      \"real_time\": " << ns << "," << std::endl
+				<< "      \"cpu_time\": " << cpuNs << "," << std::endl
+				<< "      \"time_unit\": \"ns\"" << std::endl
+				<< "    }";
+
+		first = false;
+	}
+
+	std::cout << std::endl << "  ]" << std::endl << "}" << std::endl;
+}
+
+} // namespace benchmark
+} // namespace signals
@@ -0,0 +1,116 @@
+#ifndef SIGNALS_BENCHMARKS_BENCHMARK_H__
+#define SIGNALS_BENCHMARKS_BENCHMARK_H__
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace signals {
+namespace benchmark {
+
+/**
+ * State of a running benchmark. Benchmarks loop over the state, the body of
+ * the loop is what gets measured:
+ *
+ *   void myBenchmark(State& state) {
+ *
+ *     // setup
+ *
+ *     for (auto _ : state)
+ *       // code to measure
+ *   }
+ */
+class State {
+
+public:
+
+	State(std::size_t iterations, long arg = 0) :
+		_iterations(iterations),
+		_arg(arg) {}
+
+	// non-trivial destructor to prevent unused variable warnings
+	struct Value { ~Value() {} };
+
+	class Iterator {
+
+	public:
+
+		Iterator(std::size_t remaining) : _remaining(remaining) {}
+
+		Value operator*() const { return Value(); }
+		Iterator& operator++() { _remaining--; return *this; }
+		bool operator!=(const Iterator& other) const { return _remaining != other._remaining; }
+
+	private:
+
+		std::size_t _remaining;
+	};
+
+	Iterator begin() const { return Iterator(_iterations); }
+	Iterator end() const { return Iterator(0); }
+
+	std::size_t iterations() const { return _iterations; }
+
+	/**
+	 * The argument of the benchmark, for benchmarks registered with 
+	 * SIGNALS_BENCHMARK_ARGS.
+	 */
+	long arg() const { return _arg; }
+
+private:
+
+	std::size_t _iterations;
+	long        _arg;
+};
+
+typedef void (*benchmark_function)(State&);
+
+/**
+ * Register a benchmark function. Use the SIGNALS_BENCHMARK macro instead.
+ */
+int registerBenchmark(const std::string& name, benchmark_function function);
+
+/**
+ * Register a benchmark function to be run once for each of the given 
+ * arguments. Use the SIGNALS_BENCHMARK_ARGS macro instead.
+ */
+int registerBenchmark(const std::string& name, benchmark_function function, std::vector<long> args);
+
+/**
+ * Run all registered benchmarks whose name contains filter and write the
+ * results in the JSON format of Google Benchmark to stdout.
+ */
+void runBenchmarks(const std::string& filter = "");
+
+/**
+ * Prevent the compiler from optimizing away the computation of value.
+ */
+template <typename T>
+inline void doNotOptimize(const T& value) {
+
+	asm volatile("" : : "r,m"(value) : "memory");
+}
+
+} // namespace benchmark
+} // namespace signals
+
+#define SIGNALS_BENCHMARK_CONCAT_(a, b) a##b
+#define SIGNALS_BENCHMARK_CONCAT(a, b) SIGNALS_BENCHMARK_CONCAT_(a, b)
+
+/**
+ * Register a function void(State&) as a benchmark.
+ */
+#define SIGNALS_BENCHMARK(function) \
+	static int SIGNALS_BENCHMARK_CONCAT(benchmark_, __LINE__) = \
+			::signals::benchmark::registerBenchmark(#function, function)
+
+/**
+ * Register a function void(State&) as a benchmark that is run for each of the 
+ * given arguments, see State::arg(). Results are reported as 
+ * "function/arg".
+ */
+#define SIGNALS_BENCHMARK_ARGS(function, ...) \
+	static int SIGNALS_BENCHMARK_CONCAT(benchmark_, __LINE__) = \
+			::signals::benchmark::registerBenchmark(#function, function, std::vector<long>{__VA_ARGS__})
+
+#endif // SIGNALS_BENCHMARKS_BENCHMARK_H__
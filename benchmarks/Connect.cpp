@@ -0,0 +1,236 @@
+#include <memory>
+#include <vector>
+#include <boost/make_shared.hpp>
+
+#include <signals/Callback.h>
+#include <signals/Connection.h>
+#include <signals/Receiver.h>
+#include <signals/Sender.h>
+#include <signals/Slot.h>
+#include <signals/VirtualCallback.h>
+#include <signals/VirtualCallbackInvoker.h>
+
+#include "Benchmark.h"
+
+using namespace signals;
+using namespace signals::benchmark;
+
+namespace {
+
+	struct Base    : public Signal {};
+	struct Derived : public Base {};
+	struct Other   : public Signal {};
+
+	/**
+	 * A receiver with a given number of callbacks of mixed signal types and 
+	 * invocation.
+	 */
+	struct LargeReceiver : public Receiver {
+
+		LargeReceiver(long numCallbacks) {
+
+			for (long i = 0; i < numCallbacks; i++) {
+
+				CallbackInvocation invocation = (i%4 == 0 ? Transparent : Exclusive);
+
+				switch (i%3) {
+
+					case 0:
+						registerCallback(new Callback<Base>([](Base&){}, invocation));
+						break;
+					case 1:
+						registerCallback(new Callback<Derived>([](Derived&){}, invocation));
+						break;
+					default:
+						registerCallback(new Callback<Other>([](Other&){}, invocation));
+				}
+			}
+		}
+	};
+
+	class HandlerBase {
+
+	public:
+
+		virtual ~HandlerBase() {}
+	};
+
+	template <typename SignalType>
+	class Handler : public HandlerBase {
+
+	public:
+
+		typedef HandlerBase HandlerBaseType;
+
+		virtual void onSignal(SignalType& signal) = 0;
+	};
+
+	struct BaseHandler : public Handler<Base> {
+
+		void onSignal(Base&) override {}
+	};
+
+	struct SmallSender : public Sender {
+
+		SmallSender() {
+
+			registerSlot(base);
+			registerSlot(derived);
+			registerSlot(other);
+		}
+
+		Slot<Base>    base;
+		Slot<Derived> derived;
+		Slot<Other>   other;
+	};
+
+	/**
+	 * Holder of a shared tracked callback, which also holds a connection of 
+	 * another callback to the same slot.
+	 */
+	struct ConnectedHolder {
+
+		ConnectedHolder() :
+			callback([](Base&){}),
+			other([](Base&){}) {}
+
+		Callback<Base, SharedTracking<ConnectedHolder> > callback;
+		Callback<Base> other;
+
+		// declared last to disconnect before the callbacks get destructed
+		ScopedConnection connection;
+	};
+
+	void buildReceiver(State& state) {
+
+		for (auto _ : state) {
+
+			LargeReceiver receiver(state.arg());
+			doNotOptimize(receiver);
+		}
+	}
+
+	void connectDisconnect(State& state) {
+
+		SmallSender   sender;
+		LargeReceiver receiver(state.arg());
+
+		for (auto _ : state) {
+
+			sender.connect(receiver);
+			sender.disconnect(receiver);
+		}
+	}
+
+	void connectManyReceivers(State& state) {
+
+		std::vector<std::unique_ptr<LargeReceiver> > receivers;
+		for (long i = 0; i < state.arg(); i++)
+			receivers.emplace_back(new LargeReceiver(4));
+
+		for (auto _ : state) {
+
+			SmallSender sender;
+
+			for (auto& receiver : receivers)
+				sender.connect(*receiver);
+
+			for (auto& receiver : receivers)
+				sender.disconnect(*receiver);
+		}
+	}
+
+	/**
+	 * Create a slot, connect state.arg() callbacks, and destroy it again. 
+	 * Slots with few targets should not allocate.
+	 */
+	void createSlot(State& state) {
+
+		std::vector<std::unique_ptr<Callback<Base> > > callbacks;
+		for (long i = 0; i < state.arg(); i++)
+			callbacks.emplace_back(new Callback<Base>([](Base&){}));
+
+		for (auto _ : state) {
+
+			Slot<Base> slot;
+
+			for (auto& callback : callbacks)
+				slot.addCallback(*callback);
+
+			doNotOptimize(slot);
+		}
+	}
+
+	/**
+	 * Connect a virtual callback to a slot of a more specific signal type, 
+	 * which needs a relay to the callback's handler.
+	 */
+	void connectVirtualRelay(State& state) {
+
+		BaseHandler handler;
+		VirtualCallback<Base, Handler<Base> > callback(&handler);
+
+		Slot<Derived, VirtualCallbackInvoker<Derived, Handler<Derived> > > slot;
+
+		for (auto _ : state) {
+
+			callback.connect(slot);
+			callback.disconnect(slot);
+		}
+	}
+
+	/**
+	 * Disconnect a shared tracked callback whose holder is only kept alive by 
+	 * the slot. The holder gets destructed when the replaced invokers are 
+	 * freed and disconnects from the same slot, which must not deadlock.
+	 */
+	void disconnectSharedTracked(State& state) {
+
+		Slot<Base, CallbackInvoker<Base>, MultiThreaded> slot;
+
+		for (auto _ : state) {
+
+			Connection connection;
+
+			{
+				boost::shared_ptr<ConnectedHolder> holder = boost::make_shared<ConnectedHolder>();
+				holder->callback.track(holder);
+
+				connection = slot.connect(holder->callback);
+				holder->connection = ScopedConnection(slot.connect(holder->other));
+			}
+
+			connection.disconnect();
+		}
+
+		doNotOptimize(slot);
+	}
+
+	void connectHandles(State& state) {
+
+		std::vector<std::unique_ptr<Callback<Base> > > callbacks;
+		for (long i = 0; i < state.arg(); i++)
+			callbacks.emplace_back(new Callback<Base>([](Base&){}));
+
+		std::vector<Connection> connections(callbacks.size());
+
+		for (auto _ : state) {
+
+			Slot<Base> slot;
+
+			for (size_t i = 0; i < callbacks.size(); i++)
+				connections[i] = slot.connect(*callbacks[i]);
+
+			for (auto& connection : connections)
+				connection.disconnect();
+		}
+	}
+}
+
+SIGNALS_BENCHMARK_ARGS(buildReceiver, 8, 64, 512);
+SIGNALS_BENCHMARK_ARGS(connectDisconnect, 8, 64, 512);
+SIGNALS_BENCHMARK_ARGS(connectManyReceivers, 8, 64, 512);
+SIGNALS_BENCHMARK_ARGS(createSlot, 0, 1, 2, 3);
+SIGNALS_BENCHMARK(connectVirtualRelay);
+SIGNALS_BENCHMARK_ARGS(connectHandles, 8, 512, 65536);
+SIGNALS_BENCHMARK(disconnectSharedTracked);
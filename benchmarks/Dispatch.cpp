@@ -0,0 +1,438 @@
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <boost/atomic.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/thread.hpp>
+
+#include <signals/Callback.h>
+#include <signals/Epochs.h>
+#include <signals/Receiver.h>
+#include <signals/Sender.h>
+#include <signals/Slot.h>
+#include <signals/Slots.h>
+#include <signals/VirtualCallback.h>
+#include <signals/VirtualCallbackInvoker.h>
+
+#include "Benchmark.h"
+
+using namespace signals;
+using namespace signals::benchmark;
+
+namespace {
+
+	struct Ping : public Signal {
+
+		Ping() : value(1) {}
+
+		int value;
+	};
+
+	/**
+	 * A signal that is expensive to create.
+	 */
+	struct Frame : public Signal {
+
+		Frame() : pixels(4096, 1) {}
+
+		std::vector<int> pixels;
+	};
+
+	// sink for the callbacks, to keep them from being optimized away
+	long total = 0;
+
+	struct PingReceiver : public Receiver {
+
+		PingReceiver() :
+			callback([](Ping& ping){ total += ping.value; }) {
+
+			registerCallback(callback);
+		}
+
+		Callback<Ping> callback;
+	};
+
+	struct TrackedPingReceiver : public Receiver {
+
+		TrackedPingReceiver() :
+			callback([](Ping& ping){ total += ping.value; }) {
+
+			registerCallback(callback);
+		}
+
+		Callback<Ping, WeakTracking<TrackedPingReceiver> > callback;
+	};
+
+	/**
+	 * Receiver for sends from many threads. The callback does not touch 
+	 * shared data, such that only the tracking contends.
+	 */
+	template <template <typename> class TrackingPolicy>
+	struct ContendedPingReceiver : public Receiver {
+
+		ContendedPingReceiver() :
+			callback([](Ping&){}) {
+
+			registerCallback(callback);
+		}
+
+		Callback<Ping, TrackingPolicy<ContendedPingReceiver> > callback;
+	};
+
+	// the callbacks of MixedPingReceiver append their name to this
+	std::string order;
+
+	/**
+	 * Receiver with transparent callbacks of which one is tracked. The 
+	 * callbacks are called by precedence, i.e., in the reverse order of 
+	 * registration, independent of their tracking.
+	 */
+	struct MixedPingReceiver : public Receiver {
+
+		MixedPingReceiver() :
+			a([](Ping&){ order += 'a'; }, Transparent),
+			b([](Ping&){ order += 'b'; }, Transparent),
+			c([](Ping&){ order += 'c'; }, Transparent),
+			d([](Ping&){ order += 'd'; }, Transparent) {
+
+			registerCallback(a);
+			registerCallback(b);
+			registerCallback(c);
+			registerCallback(d);
+		}
+
+		Callback<Ping> a;
+		Callback<Ping, WeakTracking<MixedPingReceiver> > b;
+		Callback<Ping> c;
+		Callback<Ping> d;
+	};
+
+	class PingHandlerBase {
+
+	public:
+
+		virtual ~PingHandlerBase() {}
+	};
+
+	class PingHandler : public PingHandlerBase {
+
+	public:
+
+		typedef PingHandlerBase HandlerBaseType;
+
+		virtual void onSignal(Ping& ping) = 0;
+	};
+
+	struct VirtualPingReceiver : public Receiver, public PingHandler {
+
+		VirtualPingReceiver() :
+			callback(this) {
+
+			registerCallback(callback);
+		}
+
+		void onSignal(Ping& ping) override { total += ping.value; }
+
+		VirtualCallback<Ping, PingHandler> callback;
+	};
+
+	template <typename SlotType>
+	struct PingSender : public Sender {
+
+		PingSender() { registerSlot(slot); }
+
+		SlotType slot;
+	};
+
+	void sendToTargets(State& state) {
+
+		PingSender<Slot<Ping> > sender;
+		std::vector<std::unique_ptr<PingReceiver> > receivers;
+
+		for (long i = 0; i < state.arg(); i++) {
+
+			receivers.emplace_back(new PingReceiver());
+			sender.connect(*receivers.back());
+		}
+
+		Ping ping;
+
+		for (auto _ : state)
+			sender.slot(ping);
+
+		doNotOptimize(total);
+	}
+
+	void sendToCallback(State& state) {
+
+		PingSender<Slot<Ping> > sender;
+		PingReceiver receiver;
+		sender.connect(receiver);
+
+		Ping ping;
+
+		for (auto _ : state)
+			sender.slot(ping);
+
+		doNotOptimize(total);
+	}
+
+	void sendToVirtualCallback(State& state) {
+
+		PingSender<Slot<Ping, VirtualCallbackInvoker<Ping, PingHandler> > > sender;
+		VirtualPingReceiver receiver;
+		sender.connect(receiver);
+
+		Ping ping;
+
+		for (auto _ : state)
+			sender.slot(ping);
+
+		doNotOptimize(total);
+	}
+
+	void sendToWeakTracked(State& state) {
+
+		PingSender<Slot<Ping> > sender;
+		boost::shared_ptr<TrackedPingReceiver> receiver = boost::make_shared<TrackedPingReceiver>();
+		receiver->callback.track(receiver);
+		sender.connect(*receiver);
+
+		Ping ping;
+
+		for (auto _ : state)
+			sender.slot(ping);
+
+		doNotOptimize(total);
+	}
+
+	/**
+	 * Send to the callbacks of a MixedPingReceiver. Checks that they are 
+	 * called in the order of their precedence.
+	 */
+	template <typename SlotType>
+	void sendToMixed(State& state, MixedPingReceiver& receiver) {
+
+		PingSender<SlotType> sender;
+		sender.connect(receiver);
+
+		Ping ping;
+
+		order.clear();
+		sender.slot(ping);
+
+		if (order != "dcba")
+			throw std::logic_error("callbacks called in order " + order + ", expected dcba");
+
+		for (auto _ : state) {
+
+			order.clear();
+			sender.slot(ping);
+		}
+
+		doNotOptimize(order);
+	}
+
+	/**
+	 * Send to callbacks with and without tracking.
+	 */
+	template <typename SlotType>
+	void sendToMixedTracking(State& state) {
+
+		boost::shared_ptr<MixedPingReceiver> receiver = boost::make_shared<MixedPingReceiver>();
+		receiver->b.track(receiver);
+
+		sendToMixed<SlotType>(state, *receiver);
+	}
+
+	void sendToMixedTrackingSingleThreaded(State& state) {
+
+		sendToMixedTracking<Slot<Ping> >(state);
+	}
+
+	void sendToMixedTrackingMultiThreaded(State& state) {
+
+		sendToMixedTracking<Slot<Ping, CallbackInvoker<Ping>, MultiThreaded> >(state);
+	}
+
+	/**
+	 * Send to callbacks with and without tracking, and with and without 
+	 * affinity to the sending thread.
+	 */
+	void sendToMixedAffinity(State& state) {
+
+		boost::shared_ptr<MixedPingReceiver> receiver = boost::make_shared<MixedPingReceiver>();
+		receiver->b.track(receiver);
+		receiver->c.setAffinity(boost::make_shared<ReceiverAffinity>([](ReceiverAffinity::task_type task){ task(); }));
+
+		sendToMixed<Slot<Ping> >(state, *receiver);
+	}
+
+	/**
+	 * Send to the given receiver, while state.arg() other threads send to it 
+	 * as well. Reading the invokers of the MultiThreaded slot only uses the 
+	 * per-thread epoch records, differences between the receivers come from 
+	 * their tracking.
+	 */
+	template <typename ReceiverType>
+	void sendContended(State& state, ReceiverType& receiver) {
+
+		PingSender<Slot<Ping, CallbackInvoker<Ping>, MultiThreaded> > sender;
+		sender.connect(receiver);
+
+		boost::atomic<bool> stop(false);
+		boost::thread_group senders;
+
+		for (long i = 0; i < state.arg(); i++)
+			senders.create_thread([&]{
+
+				Ping ping;
+
+				while (!stop.load(boost::memory_order_relaxed))
+					sender.slot(ping);
+			});
+
+		Ping ping;
+
+		for (auto _ : state)
+			sender.slot(ping);
+
+		stop = true;
+		senders.join_all();
+	}
+
+	void sendToWeakTrackedContended(State& state) {
+
+		typedef ContendedPingReceiver<WeakTracking> ReceiverType;
+
+		boost::shared_ptr<ReceiverType> receiver = boost::make_shared<ReceiverType>();
+		receiver->callback.track(receiver);
+
+		sendContended(state, *receiver);
+	}
+
+	void sendToEpochTrackedContended(State& state) {
+
+		typedef ContendedPingReceiver<EpochTracking> ReceiverType;
+
+		EpochPtr<ReceiverType> receiver(new ReceiverType());
+		receiver->callback.track(receiver);
+
+		sendContended(state, *receiver);
+	}
+
+	/**
+	 * Create and send a frame to state.arg() receivers.
+	 */
+	void sendFrame(State& state) {
+
+		PingSender<Slot<Frame> > sender;
+		std::vector<std::unique_ptr<Callback<Frame> > > callbacks;
+
+		for (long i = 0; i < state.arg(); i++) {
+
+			callbacks.emplace_back(new Callback<Frame>([](Frame& frame){ total += frame.pixels[0]; }));
+			sender.slot.connect(*callbacks.back());
+		}
+
+		for (auto _ : state)
+			sender.slot();
+
+		doNotOptimize(total);
+	}
+
+	/**
+	 * Same as sendFrame, but frames are only created if there are receivers.
+	 */
+	void emitFrameWith(State& state) {
+
+		PingSender<Slot<Frame> > sender;
+		std::vector<std::unique_ptr<Callback<Frame> > > callbacks;
+
+		for (long i = 0; i < state.arg(); i++) {
+
+			callbacks.emplace_back(new Callback<Frame>([](Frame& frame){ total += frame.pixels[0]; }));
+			sender.slot.connect(*callbacks.back());
+		}
+
+		for (auto _ : state)
+			sender.slot.emitWith([]{ return Frame(); });
+
+		doNotOptimize(total);
+	}
+
+	/**
+	 * Send a const frame to a callback that takes it as const reference 
+	 * (state.arg() == 0) or as mutable reference, which needs a copy.
+	 */
+	void sendConstFrame(State& state) {
+
+		PingSender<Slot<Frame> > sender;
+
+		Callback<Frame> readOnly([](const Frame& frame){ total += frame.pixels[0]; });
+		Callback<Frame> writable([](Frame& frame){ total += frame.pixels[0]; });
+
+		if (state.arg() == 0)
+			sender.slot.connect(readOnly);
+		else
+			sender.slot.connect(writable);
+
+		const Frame frame;
+
+		for (auto _ : state)
+			sender.slot(frame);
+
+		doNotOptimize(total);
+	}
+
+	void sendBatchToTargets(State& state) {
+
+		PingSender<Slot<Ping> > sender;
+		std::vector<std::unique_ptr<PingReceiver> > receivers;
+
+		for (long i = 0; i < 8; i++) {
+
+			receivers.emplace_back(new PingReceiver());
+			sender.connect(*receivers.back());
+		}
+
+		std::vector<Ping> pings(state.arg());
+
+		for (auto _ : state)
+			sender.slot.sendBatch(pings.data(), pings.data() + pings.size());
+
+		doNotOptimize(total);
+	}
+
+	void broadcastToSlots(State& state) {
+
+		Slots<Ping>  slots;
+		PingReceiver receiver;
+
+		for (long i = 0; i < state.arg(); i++)
+			receiver.callback.connect(*slots.get(slots.add()));
+
+		Ping ping;
+
+		for (auto _ : state)
+			slots.broadcast(ping);
+
+		doNotOptimize(total);
+	}
+}
+
+SIGNALS_BENCHMARK_ARGS(sendToTargets, 0, 1, 8, 1024);
+SIGNALS_BENCHMARK(sendToCallback);
+SIGNALS_BENCHMARK(sendToVirtualCallback);
+SIGNALS_BENCHMARK(sendToWeakTracked);
+SIGNALS_BENCHMARK(sendToMixedTrackingSingleThreaded);
+SIGNALS_BENCHMARK(sendToMixedTrackingMultiThreaded);
+SIGNALS_BENCHMARK(sendToMixedAffinity);
+SIGNALS_BENCHMARK_ARGS(sendToWeakTrackedContended, 0, 1, 3, 7);
+SIGNALS_BENCHMARK_ARGS(sendToEpochTrackedContended, 0, 1, 3, 7);
+SIGNALS_BENCHMARK_ARGS(sendFrame, 0, 1);
+SIGNALS_BENCHMARK_ARGS(emitFrameWith, 0, 1);
+SIGNALS_BENCHMARK_ARGS(sendConstFrame, 0, 1);
+SIGNALS_BENCHMARK_ARGS(sendBatchToTargets, 1, 64, 1024);
+SIGNALS_BENCHMARK_ARGS(broadcastToSlots, 8, 1024);
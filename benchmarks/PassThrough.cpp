@@ -0,0 +1,125 @@
+#include <memory>
+#include <vector>
+
+#include <signals/Callback.h>
+#include <signals/PassThroughCallback.h>
+#include <signals/PassThroughSlot.h>
+#include <signals/Receiver.h>
+#include <signals/Sender.h>
+#include <signals/Slot.h>
+
+#include "Benchmark.h"
+
+using namespace signals;
+using namespace signals::benchmark;
+
+namespace {
+
+	struct Ping : public Signal {};
+
+	long total = 0;
+
+	/**
+	 * One level of a pass-through chain: receives signals via a 
+	 * PassThroughCallback and forwards them via a PassThroughSlot.
+	 */
+	struct Tunnel {
+
+		Tunnel() {
+
+			callback.forwardTo(slot);
+			receiver.registerCallback(callback);
+			sender.registerSlot(slot);
+		}
+
+		Receiver               receiver;
+		Sender                 sender;
+		PassThroughCallback<>  callback;
+		PassThroughSlot<>      slot;
+	};
+
+	struct PingSender : public Sender {
+
+		PingSender() { registerSlot(slot); }
+
+		Slot<Ping> slot;
+	};
+
+	struct PingReceiver : public Receiver {
+
+		PingReceiver() :
+			callback([](Ping&){ total++; }) {
+
+			registerCallback(callback);
+		}
+
+		Callback<Ping> callback;
+	};
+
+	/**
+	 * A sender, connected to a chain of the given depth of tunnels.
+	 */
+	struct Chain {
+
+		Chain(long depth, bool connectHead = true) {
+
+			for (long i = 0; i < depth; i++)
+				tunnels.emplace_back(new Tunnel());
+
+			for (long i = 1; i < depth; i++)
+				tunnels[i - 1]->sender.connect(tunnels[i]->receiver);
+
+			if (connectHead)
+				sender.connect(tunnels.front()->receiver);
+		}
+
+		Sender& end() {
+
+			return tunnels.empty() ? static_cast<Sender&>(sender) : tunnels.back()->sender;
+		}
+
+		PingSender sender;
+		std::vector<std::unique_ptr<Tunnel> > tunnels;
+	};
+
+	void connectThroughChain(State& state) {
+
+		Chain chain(state.arg());
+		PingReceiver receiver;
+
+		for (auto _ : state) {
+
+			chain.end().connect(receiver);
+			chain.end().disconnect(receiver);
+		}
+	}
+
+	void connectChainHead(State& state) {
+
+		Chain chain(state.arg(), false);
+		PingReceiver receiver;
+		chain.end().connect(receiver);
+
+		for (auto _ : state) {
+
+			chain.sender.connect(chain.tunnels.front()->receiver);
+			chain.sender.disconnect(chain.tunnels.front()->receiver);
+		}
+	}
+
+	void sendThroughChain(State& state) {
+
+		Chain chain(state.arg());
+		PingReceiver receiver;
+		chain.end().connect(receiver);
+
+		for (auto _ : state)
+			chain.sender.slot();
+
+		doNotOptimize(total);
+	}
+}
+
+SIGNALS_BENCHMARK_ARGS(connectThroughChain, 1, 4, 16);
+SIGNALS_BENCHMARK_ARGS(connectChainHead, 1, 4, 16);
+SIGNALS_BENCHMARK_ARGS(sendThroughChain, 1, 4, 16);
@@ -0,0 +1,155 @@
+#include <cstring>
+#include <string>
+#include <vector>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <boost/atomic.hpp>
+#include <boost/thread.hpp>
+
+#include <signals/Callback.h>
+#include <signals/PayloadSignal.h>
+#include <signals/Receiver.h>
+#include <signals/SharedMemoryReceiver.h>
+#include <signals/SharedMemorySlot.h>
+
+#include "Benchmark.h"
+
+using namespace signals;
+using namespace signals::benchmark;
+
+namespace {
+
+	struct Position {
+
+		double        x, y, z;
+		std::uint64_t frame;
+	};
+
+	struct Moved : public PayloadSignal<Position> {};
+
+	/**
+	 * Counts the signals it receives.
+	 */
+	struct MovedReceiver : public Receiver {
+
+		MovedReceiver() :
+			received(0),
+			callback([this](Moved&){ received.fetch_add(1, boost::memory_order_release); }) {
+
+			registerCallback(callback);
+		}
+
+		boost::atomic<long> received;
+
+		Callback<Moved> callback;
+	};
+
+	/**
+	 * Send signals through a shared memory ring to a receiver in another 
+	 * thread. The thread stands in for another process, the transport is the 
+	 * same.
+	 */
+	void sendThroughSharedMemory(State& state) {
+
+		std::string name = "/signals_benchmark." + std::to_string(getpid());
+		SharedMemoryRing::remove(name);
+
+		SharedMemoryReceiver<Moved> transport(name, 4096);
+		SharedMemorySlot<Moved>     slot(name, 4096);
+		MovedReceiver               receiver;
+		boost::atomic<bool>         stop(false);
+
+		transport.connect(receiver);
+
+		boost::thread consumer([&]{
+
+			while (!stop.load(boost::memory_order_acquire))
+				if (transport.poll() == 0)
+					boost::this_thread::yield();
+		});
+
+		Moved moved;
+		long  sent = 0;
+
+		for (auto _ : state) {
+
+			for (long i = 0; i < state.arg(); i++)
+				slot(moved);
+
+			sent += state.arg();
+
+			while (receiver.received.load(boost::memory_order_acquire) < sent)
+				boost::this_thread::yield();
+		}
+
+		stop.store(true, boost::memory_order_release);
+		consumer.join();
+
+		SharedMemoryRing::remove(name);
+	}
+
+	/**
+	 * Baseline: send the same payloads through a Unix domain socket.
+	 */
+	void sendThroughSocket(State& state) {
+
+		int sockets[2];
+		if (socketpair(AF_UNIX, SOCK_STREAM, 0, sockets) != 0)
+			return;
+
+		Slot<Moved>         local;
+		MovedReceiver       receiver;
+		boost::atomic<bool> stop(false);
+
+		receiver.callback.connect(local);
+
+		boost::thread consumer([&]{
+
+			std::vector<Moved> batch(64);
+			std::vector<Position> buffer(64);
+			std::size_t bytes = 0;
+
+			while (!stop.load(boost::memory_order_acquire)) {
+
+				ssize_t n = read(sockets[1], reinterpret_cast<char*>(buffer.data()) + bytes, buffer.size()*sizeof(Position) - bytes);
+				if (n <= 0)
+					break;
+
+				bytes += n;
+
+				std::size_t size = bytes/sizeof(Position);
+				for (std::size_t i = 0; i < size; i++)
+					batch[i].payload = buffer[i];
+
+				local.sendBatch(batch.data(), batch.data() + size);
+
+				// keep the incomplete record
+				std::memmove(buffer.data(), buffer.data() + size, bytes - size*sizeof(Position));
+				bytes -= size*sizeof(Position);
+			}
+		});
+
+		Moved moved;
+		long  sent = 0;
+
+		for (auto _ : state) {
+
+			for (long i = 0; i < state.arg(); i++)
+				if (write(sockets[0], &moved.payload, sizeof(Position)) != sizeof(Position))
+					break;
+
+			sent += state.arg();
+
+			while (receiver.received.load(boost::memory_order_acquire) < sent)
+				boost::this_thread::yield();
+		}
+
+		stop.store(true, boost::memory_order_release);
+		close(sockets[0]);
+		consumer.join();
+		close(sockets[1]);
+	}
+}
+
+SIGNALS_BENCHMARK_ARGS(sendThroughSharedMemory, 1, 1024);
+SIGNALS_BENCHMARK_ARGS(sendThroughSocket, 1, 1024);
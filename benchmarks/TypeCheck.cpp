@@ -0,0 +1,52 @@
+#include <signals/Signal.h>
+#include <signals/SignalTraits.h>
+#include <signals/SignalTypes.h>
+
+#include "Benchmark.h"
+
+using namespace signals;
+using namespace signals::benchmark;
+
+namespace {
+
+	struct Base         : public Signal {};
+	struct Intermediate : public Base {};
+	struct Derived      : public Intermediate {};
+	struct Unrelated    : public Signal {};
+
+	// type test as it was done before signal type ids (a dynamic_cast on the
+	// reference signal of the other side)
+	template <typename SignalType>
+	bool rttiAccepts(const Signal& reference) {
+
+		return dynamic_cast<const SignalType*>(&reference);
+	}
+
+	void typeCheckRtti(State& state) {
+
+		const Signal& derived   = SignalTraits<Derived>::Reference;
+		const Signal& unrelated = SignalTraits<Unrelated>::Reference;
+
+		for (auto _ : state) {
+
+			doNotOptimize(rttiAccepts<Base>(derived));
+			doNotOptimize(rttiAccepts<Base>(unrelated));
+		}
+	}
+
+	void typeCheckTable(State& state) {
+
+		SignalTypeId base      = SignalTraits<Base>::id();
+		SignalTypeId derived   = SignalTraits<Derived>::id();
+		SignalTypeId unrelated = SignalTraits<Unrelated>::id();
+
+		for (auto _ : state) {
+
+			doNotOptimize(SignalTypes::isCompatible(derived, base));
+			doNotOptimize(SignalTypes::isCompatible(unrelated, base));
+		}
+	}
+}
+
+SIGNALS_BENCHMARK(typeCheckRtti);
+SIGNALS_BENCHMARK(typeCheckTable);
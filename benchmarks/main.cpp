@@ -0,0 +1,14 @@
+#include <string>
+
+#include "Benchmark.h"
+
+/**
+ * Runs all signals benchmarks. An optional argument restricts the benchmarks
+ * to the ones whose name contains the argument.
+ */
+int main(int argc, char** argv) {
+
+	signals::benchmark::runBenchmarks(argc > 1 ? argv[1] : "");
+
+	return 0;
+}